@@ -0,0 +1,13 @@
+set(CMAKE_CXX_STANDARD 17)
+# 性能测试程序: bench目录下每个cpp文件生成一个同名可执行文件
+find_package(Threads REQUIRED)
+file(GLOB BENCH_FILES bench/*.cpp)
+foreach (filepath ${BENCH_FILES})
+    get_filename_component(bench_name ${filepath} NAME_WE)
+    add_executable(${bench_name} ${filepath} ${SRCS})
+    target_link_libraries(${bench_name} ${NVML_LIBS} ${OPENSSL_LIBS} ${SQLITE3_LIBS} ${BREAKPAD_LIBS} ${SPDLOG_LIBS} ${HASP_ADAPTER_LIBS} ${OPENCV_LIBS} Threads::Threads)
+    target_compile_options(${bench_name} PRIVATE $<$<CXX_COMPILER_ID:MSVC>:/utf-8>)
+    if(WIN32)
+        target_compile_definitions(${bench_name} PRIVATE JADE_TOOLS_EXPORTS)
+    endif()
+endforeach (filepath)
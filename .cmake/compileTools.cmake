@@ -0,0 +1,13 @@
+set(CMAKE_CXX_STANDARD 17)
+# 工具程序: tools目录下每个cpp文件生成一个同名可执行文件
+find_package(Threads REQUIRED)
+file(GLOB TOOL_FILES tools/*.cpp)
+foreach (filepath ${TOOL_FILES})
+    get_filename_component(tool_name ${filepath} NAME_WE)
+    add_executable(${tool_name} ${filepath} ${SRCS})
+    target_link_libraries(${tool_name} ${NVML_LIBS} ${OPENSSL_LIBS} ${SQLITE3_LIBS} ${BREAKPAD_LIBS} ${SPDLOG_LIBS} ${HASP_ADAPTER_LIBS} ${OPENCV_LIBS} Threads::Threads)
+    target_compile_options(${tool_name} PRIVATE $<$<CXX_COMPILER_ID:MSVC>:/utf-8>)
+    if(WIN32)
+        target_compile_definitions(${tool_name} PRIVATE JADE_TOOLS_EXPORTS)
+    endif()
+endforeach (filepath)
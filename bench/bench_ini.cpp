@@ -0,0 +1,170 @@
+/**
+# @File     : bench_ini.cpp
+# @Author   : jade
+# @Date     : 2026/10/19 18:10
+# @Email    : jadehh@1ive.com
+# @Software : Samples
+# @Desc     : INIReader 加载与查询性能测试
+#
+# 用法: bench_ini [--keys 100000] [--per-section 50] [--lookups 100000] [--file bench_ini.ini]
+#   生成 1000, 10000, ... keys 个键的配置文件(每个节per-section个键,与相机配置的结构一致),
+#   测量加载耗时、每秒加载的键数,随机按节名/键名查询的耗时,通过预先查找的Key读取的耗时,
+#   按前缀读取一个节内Param1*的耗时,以及从ConfigCache二进制缓存加载的耗时;加载时间应随键数线性增长
+*/
+#include "include/jade_tools.h"
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+    struct BenchConfig
+    {
+        int keys = 100000;
+        int perSection = 50;
+        int lookups = 100000;
+        std::string file = "bench_ini.ini";
+    };
+
+    BenchConfig parseArgs(const int argc, char* argv[])
+    {
+        BenchConfig config;
+        for (int i = 1; i + 1 < argc; i += 2)
+        {
+            const std::string key = argv[i];
+            const std::string value = argv[i + 1];
+            if (key == "--keys")
+                config.keys = std::stoi(value);
+            else if (key == "--per-section")
+                config.perSection = std::max(1, std::stoi(value));
+            else if (key == "--lookups")
+                config.lookups = std::stoi(value);
+            else if (key == "--file")
+                config.file = value;
+            else
+                std::cerr << "未知参数: " << key << std::endl;
+        }
+        return config;
+    }
+
+    std::string sectionName(const int index)
+    {
+        return "Camera" + std::to_string(index);
+    }
+
+    std::string keyName(const int index)
+    {
+        return "Param" + std::to_string(index);
+    }
+
+    // 生成keys个键的配置文件,返回文件大小
+    size_t writeConfig(const BenchConfig& config, const int keys)
+    {
+        std::ofstream out(config.file, std::ios::binary | std::ios::trunc);
+        for (int i = 0; i < keys; ++i)
+        {
+            if (i % config.perSection == 0)
+            {
+                out << "[" << sectionName(i / config.perSection) << "]\n";
+            }
+            out << keyName(i % config.perSection) << " = " << i * 0.5 << "    ; 第" << i << "个参数\n";
+        }
+        return static_cast<size_t>(out.tellp());
+    }
+
+    double elapsedMs(const std::chrono::steady_clock::time_point begin)
+    {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+    }
+}
+
+int main(const int argc, char* argv[])
+{
+    const BenchConfig config = parseArgs(argc, argv);
+    jade::Logger::getInstance().init("bench_ini", "bench", "Logs", jade::Logger::S_WARNING, true, false);
+    std::vector<std::vector<std::string>> rows;
+    for (int keys = 1000; keys <= config.keys; keys *= 10)
+    {
+        const size_t bytes = writeConfig(config, keys);
+        auto begin = std::chrono::steady_clock::now();
+        const jade::INIReader reader(config.file);
+        const double loadMs = elapsedMs(begin);
+        if (reader.ParseError() != 0)
+        {
+            std::cerr << "解析失败: " << reader.ParseError() << std::endl;
+        }
+
+        std::mt19937 random(0);
+        std::uniform_int_distribution<int> index(0, keys - 1);
+        double sum = 0;
+        begin = std::chrono::steady_clock::now();
+        for (int i = 0; i < config.lookups; ++i)
+        {
+            const int key = index(random);
+            sum += reader.GetReal(sectionName(key / config.perSection), keyName(key % config.perSection), 0);
+        }
+        const double lookupMs = elapsedMs(begin);
+
+        // 预先查找所有键,按Key读取
+        std::vector<jade::INIReader::Key> handles;
+        handles.reserve(keys);
+        for (int i = 0; i < keys; ++i)
+        {
+            handles.push_back(reader.key(sectionName(i / config.perSection), keyName(i % config.perSection)));
+        }
+        random.seed(0);
+        double keySum = 0;
+        begin = std::chrono::steady_clock::now();
+        for (int i = 0; i < config.lookups; ++i)
+        {
+            keySum += reader.GetReal(handles[index(random)], 0);
+        }
+        const double keyLookupMs = elapsedMs(begin);
+        if (keySum != sum)
+        {
+            std::cerr << "按Key读取的结果不一致: " << keySum << " != " << sum << std::endl;
+        }
+
+        // 按前缀读取随机节内的Param1, Param10~Param19, ...
+        std::uniform_int_distribution<int> section(0, (keys - 1) / config.perSection);
+        size_t prefixValues = 0;
+        begin = std::chrono::steady_clock::now();
+        for (int i = 0; i < config.lookups; ++i)
+        {
+            prefixValues += reader.GetRealWithPrefix(sectionName(section(random)), "Param1").size();
+        }
+        const double prefixMs = elapsedMs(begin);
+
+        // 预先生成二进制缓存,测量启动时映射并校验缓存的耗时
+        const std::string cacheFile = config.file + ".cache";
+        double cacheMs = -1;
+        if (jade::ConfigCache::compile(config.file, jade::ConfigCache::Format::INI, cacheFile))
+        {
+            jade::ConfigCache cache;
+            begin = std::chrono::steady_clock::now();
+            const bool cached = cache.open(config.file, jade::ConfigCache::Format::INI, cacheFile) && cache.fromCache();
+            cacheMs = elapsedMs(begin);
+            if (!cached || cache.GetReal(sectionName(0), keyName(1), -1) != reader.GetReal(sectionName(0), keyName(1), 0))
+            {
+                std::cerr << "缓存加载失败" << std::endl;
+            }
+        }
+        std::remove(cacheFile.c_str());
+        rows.push_back({
+            std::to_string(keys), jade::formatValue(static_cast<double>(bytes) / (1024 * 1024)),
+            jade::formatValue(loadMs, 1), jade::formatValue(keys / loadMs * 1000, 0), jade::formatValue(cacheMs, 2),
+            jade::formatValue(lookupMs * 1e6 / std::max(1, config.lookups), 0),
+            jade::formatValue(keyLookupMs * 1e6 / std::max(1, config.lookups), 1),
+            jade::formatValue(prefixMs * 1e6 / std::max(1, config.lookups), 0),
+            jade::formatValue(static_cast<double>(prefixValues) / std::max(1, config.lookups), 1), jade::formatValue(sum, 0)
+        });
+    }
+    jade::printPrettyTable({"键数", "文件大小(MB)", "加载耗时(ms)", "加载键/s", "缓存加载(ms)", "单次查询(ns)", "Key查询(ns)", "前缀查询(ns)", "前缀键数", "校验和"}, rows);
+    std::remove(config.file.c_str());
+    jade::Logger::getInstance().shutDown();
+    return 0;
+}
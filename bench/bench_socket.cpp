@@ -0,0 +1,361 @@
+/**
+# @File     : bench_socket.cpp
+# @Author   : jade
+# @Date     : 2026/10/19 09:30
+# @Email    : jadehh@1ive.com
+# @Software : Samples
+# @Desc     : SocketServer 回环吞吐量与延迟测试
+#
+# 用法: bench_socket [--mode rr|stream] [--connections 16] [--size 256] [--requests 500] [--port 18099]
+#   rr     : 请求/响应,每个连接发送一个消息后等待服务端原样回写的响应,再发送下一个
+#   stream : 每个连接连续发送 requests 个消息,服务端只接收不回写
+# 连接在测试期间保持不变,消息使用Framing::LENGTH_PREFIXED分帧(4字节大端长度头);
+# 消息数与流量取自服务端getStats的增量。延迟在rr模式下为客户端测得的单个请求往返时间,
+# 在stream模式下为消息从客户端发送到服务端回调的时间(消息前8字节为发送时刻)
+*/
+#include "include/jade_tools.h"
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#ifdef _WIN32
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#pragma comment(lib, "ws2_32.lib")
+#else
+#include <sys/socket.h>
+#include <sys/resource.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <unistd.h>
+#include <ctime>
+#endif
+
+namespace
+{
+    struct BenchConfig
+    {
+        std::string mode = "rr";
+        int connections = 16;
+        size_t size = 256;
+        int requests = 500;
+        int port = 18099;
+    };
+
+    // 当前进程消耗的CPU时间(秒)
+    double processCpuSeconds()
+    {
+#ifdef _WIN32
+        FILETIME create, exit, kernel, user;
+        GetProcessTimes(GetCurrentProcess(), &create, &exit, &kernel, &user);
+        const auto toSeconds = [](const FILETIME& t)
+        {
+            return static_cast<double>(static_cast<uint64_t>(t.dwHighDateTime) << 32 | t.dwLowDateTime) / 1e7;
+        };
+        return toSeconds(kernel) + toSeconds(user);
+#else
+        rusage usage{};
+        getrusage(RUSAGE_SELF, &usage);
+        return static_cast<double>(usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) +
+            static_cast<double>(usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) / 1e6;
+#endif
+    }
+
+    // 当前线程消耗的CPU时间(秒),用于从进程CPU中扣除客户端线程
+    double threadCpuSeconds()
+    {
+#ifdef _WIN32
+        FILETIME create, exit, kernel, user;
+        GetThreadTimes(GetCurrentThread(), &create, &exit, &kernel, &user);
+        const auto toSeconds = [](const FILETIME& t)
+        {
+            return static_cast<double>(static_cast<uint64_t>(t.dwHighDateTime) << 32 | t.dwLowDateTime) / 1e7;
+        };
+        return toSeconds(kernel) + toSeconds(user);
+#else
+        timespec ts{};
+        clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+        return static_cast<double>(ts.tv_sec) + static_cast<double>(ts.tv_nsec) / 1e9;
+#endif
+    }
+
+    SOCKET_TYPE connectLoopback(const int port)
+    {
+        const SOCKET_TYPE fd = socket(AF_INET, SOCK_STREAM, 0);
+        sockaddr_in address{};
+        address.sin_family = AF_INET;
+        address.sin_port = htons(port);
+        inet_pton(AF_INET, "127.0.0.1", &address.sin_addr);
+        if (connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0)
+        {
+            throw std::runtime_error("connect failed");
+        }
+        return fd;
+    }
+
+    void closeFd(const SOCKET_TYPE fd)
+    {
+#ifdef _WIN32
+        closesocket(fd);
+#else
+        close(fd);
+#endif
+    }
+
+    bool sendAll(const SOCKET_TYPE fd, const char* data, size_t size)
+    {
+        while (size > 0)
+        {
+            const int n = send(fd, data, static_cast<int>(size), 0);
+            if (n <= 0)
+                return false;
+            data += n;
+            size -= n;
+        }
+        return true;
+    }
+
+    bool recvAll(const SOCKET_TYPE fd, char* data, size_t size)
+    {
+        while (size > 0)
+        {
+            const int n = recv(fd, data, static_cast<int>(size), 0);
+            if (n <= 0)
+                return false;
+            data += n;
+            size -= n;
+        }
+        return true;
+    }
+
+    // 长度头 + size字节的消息体,与Framing::LENGTH_PREFIXED一致
+    std::string makeFrame(const size_t size)
+    {
+        const auto length = static_cast<uint32_t>(size);
+        std::string frame = {
+            static_cast<char>(length >> 24), static_cast<char>(length >> 16), static_cast<char>(length >> 8),
+            static_cast<char>(length)
+        };
+        frame.append(size, 'x');
+        return frame;
+    }
+
+    // 读取一个帧,返回消息体的长度,失败时返回-1
+    long recvFrame(const SOCKET_TYPE fd, std::vector<char>& body)
+    {
+        unsigned char header[4];
+        if (!recvAll(fd, reinterpret_cast<char*>(header), sizeof(header)))
+            return -1;
+        const uint32_t length = static_cast<uint32_t>(header[0]) << 24 | static_cast<uint32_t>(header[1]) << 16 |
+            static_cast<uint32_t>(header[2]) << 8 | header[3];
+        body.resize(length);
+        return recvAll(fd, body.data(), length) ? static_cast<long>(length) : -1;
+    }
+
+    int64_t steadyNanos()
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    double percentile(const std::vector<double>& sorted, const double p)
+    {
+        if (sorted.empty())
+            return 0;
+        const auto index = std::min(sorted.size() - 1, static_cast<size_t>(p * static_cast<double>(sorted.size())));
+        return sorted[index];
+    }
+
+    BenchConfig parseArgs(const int argc, char* argv[])
+    {
+        BenchConfig config;
+        for (int i = 1; i + 1 < argc; i += 2)
+        {
+            const std::string key = argv[i];
+            const std::string value = argv[i + 1];
+            if (key == "--mode")
+                config.mode = value;
+            else if (key == "--connections")
+                config.connections = std::stoi(value);
+            else if (key == "--size")
+                config.size = std::stoul(value);
+            else if (key == "--requests")
+                config.requests = std::stoi(value);
+            else if (key == "--port")
+                config.port = std::stoi(value);
+            else
+                std::cerr << "未知参数: " << key << std::endl;
+        }
+        return config;
+    }
+}
+
+int main(const int argc, char* argv[])
+{
+    BenchConfig config = parseArgs(argc, argv);
+    const bool requestResponse = config.mode == "rr";
+    // stream模式在消息前8字节写入发送时刻
+    config.size = std::max<size_t>(config.size, sizeof(int64_t));
+    jade::Logger::getInstance().init("bench_socket", "bench", "Logs", jade::Logger::S_WARNING, true, false);
+
+    std::mutex deliveryMutex;
+    std::vector<double> deliveries; // stream模式下服务端测得的发送到回调的延迟
+    deliveries.reserve(static_cast<size_t>(config.connections) * config.requests);
+    jade::SocketServer* server = nullptr;
+    jade::SocketServer::Options options;
+    options.framing = jade::SocketServer::Framing::LENGTH_PREFIXED;
+    jade::SocketServer socketServer(config.port, [&](const SOCKET_TYPE client, char* data, const size_t size)
+    {
+        if (requestResponse)
+        {
+            (void)server->send(client, data, size);
+        }
+        else if (size >= sizeof(int64_t))
+        {
+            int64_t sentNs;
+            std::memcpy(&sentNs, data, sizeof(sentNs));
+            const double latency = static_cast<double>(steadyNanos() - sentNs) / 1e3;
+            std::lock_guard lock(deliveryMutex);
+            deliveries.push_back(latency);
+        }
+    }, options);
+    server = &socketServer;
+    socketServer.start();
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    std::vector<std::vector<double>> latencies(config.connections);
+    std::vector<double> clientCpu(config.connections, 0);
+    std::atomic<int> failures{0};
+
+    // 先建立全部连接,测试期间不再建立新连接
+    std::vector<SOCKET_TYPE> sockets;
+    try
+    {
+        for (int c = 0; c < config.connections; ++c)
+            sockets.push_back(connectLoopback(config.port));
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << e.what() << std::endl;
+        for (const SOCKET_TYPE fd : sockets)
+            closeFd(fd);
+        socketServer.stop();
+        jade::Logger::getInstance().shutDown();
+        return 1;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    const auto startStats = socketServer.getStats();
+    const double cpuStart = processCpuSeconds();
+    const auto wallStart = std::chrono::steady_clock::now();
+    std::vector<std::thread> clients;
+    clients.reserve(config.connections);
+    for (int c = 0; c < config.connections; ++c)
+    {
+        clients.emplace_back([&, c]
+        {
+            const double threadStart = threadCpuSeconds();
+            const SOCKET_TYPE fd = sockets[c];
+            std::string frame = makeFrame(config.size);
+            if (requestResponse)
+            {
+                auto& samples = latencies[c];
+                samples.reserve(config.requests);
+                std::vector<char> response;
+                for (int r = 0; r < config.requests; ++r)
+                {
+                    const auto begin = std::chrono::steady_clock::now();
+                    if (!sendAll(fd, frame.data(), frame.size()) ||
+                        recvFrame(fd, response) != static_cast<long>(config.size))
+                    {
+                        ++failures;
+                        break;
+                    }
+                    samples.push_back(std::chrono::duration<double, std::micro>(
+                        std::chrono::steady_clock::now() - begin).count());
+                }
+            }
+            else
+            {
+                for (int r = 0; r < config.requests; ++r)
+                {
+                    const int64_t sentNs = steadyNanos();
+                    std::memcpy(&frame[4], &sentNs, sizeof(sentNs));
+                    if (!sendAll(fd, frame.data(), frame.size()))
+                    {
+                        ++failures;
+                        break;
+                    }
+                }
+            }
+            clientCpu[c] = threadCpuSeconds() - threadStart;
+        });
+    }
+    for (auto& client : clients)
+    {
+        client.join();
+    }
+    // stream模式下客户端写完不代表服务端已收到,等待服务端回调完全部消息
+    const uint64_t expected = static_cast<uint64_t>(config.connections - failures.load()) * config.requests;
+    auto stats = socketServer.getStats();
+    const auto waitDeadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (stats.messagesIn - startStats.messagesIn < expected && std::chrono::steady_clock::now() < waitDeadline)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        stats = socketServer.getStats();
+    }
+    const double wallSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - wallStart).count();
+    double clientCpuSeconds = 0;
+    for (const double cpu : clientCpu)
+        clientCpuSeconds += cpu;
+    const double serverCpuSeconds = std::max(0.0, processCpuSeconds() - cpuStart - clientCpuSeconds);
+    for (const SOCKET_TYPE fd : sockets)
+        closeFd(fd);
+    socketServer.stop();
+
+    std::vector<double> all;
+    if (requestResponse)
+    {
+        for (const auto& samples : latencies)
+            all.insert(all.end(), samples.begin(), samples.end());
+    }
+    else
+    {
+        std::lock_guard lock(deliveryMutex);
+        all = deliveries;
+    }
+    std::sort(all.begin(), all.end());
+
+    const uint64_t messages = stats.messagesIn - startStats.messagesIn;
+    // 服务端接收和发送的字节数(含长度头)
+    const auto bytes = static_cast<double>(stats.bytesIn - startStats.bytesIn + stats.bytesOut - startStats.bytesOut);
+    jade::printPrettyTable(
+        {"模式", "连接数", "消息大小(B)", "服务端消息数", "消息/s", "MB/s", "p50(us)", "p99(us)", "p999(us)", "服务端CPU(%)", "失败数"},
+        {{
+            config.mode, std::to_string(config.connections), std::to_string(config.size),
+            std::to_string(messages),
+            jade::formatValue(static_cast<double>(messages) / wallSeconds, 0),
+            jade::formatValue(bytes / wallSeconds / (1024 * 1024)),
+            jade::formatValue(percentile(all, 0.50), 1),
+            jade::formatValue(percentile(all, 0.99), 1),
+            jade::formatValue(percentile(all, 0.999), 1),
+            jade::formatValue(serverCpuSeconds / wallSeconds * 100, 1),
+            std::to_string(failures.load())
+        }});
+    // 服务端自身统计的连接与流量
+    jade::printPrettyTable(
+        {"累计连接", "拒绝连接", "接收消息", "发送消息", "接收MB", "发送MB", "分帧错误"},
+        {{
+            std::to_string(stats.totalConnections), std::to_string(stats.rejectedConnections),
+            std::to_string(stats.messagesIn), std::to_string(stats.messagesOut),
+            jade::formatValue(static_cast<double>(stats.bytesIn) / (1024 * 1024)),
+            jade::formatValue(static_cast<double>(stats.bytesOut) / (1024 * 1024)),
+            std::to_string(stats.framingErrors)
+        }});
+    jade::Logger::getInstance().shutDown();
+    return failures == 0 && messages == expected ? 0 : 1;
+}
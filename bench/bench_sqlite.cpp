@@ -0,0 +1,757 @@
+/**
+# @File     : bench_sqlite.cpp
+# @Author   : jade
+# @Date     : 2026/10/19 14:20
+# @Email    : jadehh@1ive.com
+# @Software : Samples
+# @Desc     : SqliteHelper 性能测试
+#
+# 用法: bench_sqlite [--case suite|read|async|bulk|param|profile|multi|retention] [--db bench_sqlite.db] [--rows 100000]
+#                    [--queries 20000] [--threads 8] [--inserts 5000] [--json result.json]
+#   suite : 逐条插入、批量插入、点查询、范围扫描以及threads个读线程与一个写线程并发,输出吞吐和p50/p99延迟
+#   read  : WAL模式下按主键并发点查询,对比单连接与只读连接池在1..threads个线程下的QPS
+#   async : threads个线程各插入inserts/threads条事件,对比逐条executeWithParams与executeAsync批量写入
+#   bulk  : 单线程插入rows条事件,对比逐条executeWithParams、事务内逐条executeWithParams与executeBatch
+#   param : 单线程按主键点查询queries次,对比拼接SQL、位置参数与命名参数
+#   profile : 对比durable/balanced/throughput预设下的逐条提交、批量插入rows条、点查询与WAL文件大小
+#   multi : threads个线程共插入inserts条事件,对比所有线程写同一个数据库与每个线程写独立的SqliteHelper实例
+#   retention : rows条事件均匀分布在7天内,对比单表DELETE最早一天与EventStore删除过期分区的耗时
+# 指定--json时所有结果表同时写入JSON文件,便于比较修改锁、语句缓存或PRAGMA前后的结果
+*/
+#include "include/jade_tools.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#ifdef LOW_GCC
+#include <experimental/filesystem>
+namespace fs = std::experimental::filesystem;
+#else
+#include <filesystem>
+namespace fs = std::filesystem;
+#endif
+
+namespace
+{
+    struct BenchConfig
+    {
+        std::string benchCase = "suite";
+        std::string db = "bench_sqlite.db";
+        int rows = 100000;
+        int queries = 20000;
+        int threads = 8;
+        int inserts = 5000;
+        std::string json; // 为空时不输出JSON
+    };
+
+    struct ResultTable
+    {
+        std::string name;
+        std::vector<std::string> headers;
+        std::vector<std::vector<std::string>> rows;
+    };
+
+    std::vector<ResultTable>& results()
+    {
+        static std::vector<ResultTable> tables;
+        return tables;
+    }
+
+    // 打印结果表并记录下来,结束时写入JSON
+    void report(const std::string& name, const std::vector<std::string>& headers,
+                const std::vector<std::vector<std::string>>& rows)
+    {
+        jade::printPrettyTable(headers, rows);
+        results().push_back({name, headers, rows});
+    }
+
+    std::string jsonString(const std::string& text)
+    {
+        std::string out = "\"";
+        for (const char c : text)
+        {
+            switch (c)
+            {
+            case '"': out += "\\\""; break;
+            case '\\': out += "\\\\"; break;
+            case '\n': out += "\\n"; break;
+            case '\t': out += "\\t"; break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20)
+                {
+                    char buffer[8];
+                    snprintf(buffer, sizeof(buffer), "\\u%04x", c);
+                    out += buffer;
+                }
+                else
+                {
+                    out += c;
+                }
+            }
+        }
+        return out + "\"";
+    }
+
+    // 表格中的数字按数字输出,其余按字符串输出
+    std::string jsonValue(const std::string& text)
+    {
+        char* end = nullptr;
+        std::strtod(text.c_str(), &end);
+        const bool numeric = !text.empty() && end == text.c_str() + text.size() &&
+            text.find_first_not_of("0123456789+-.eE") == std::string::npos;
+        return numeric ? text : jsonString(text);
+    }
+
+    void writeJson(const BenchConfig& config)
+    {
+        std::ofstream out(config.json);
+        if (!out)
+        {
+            std::cerr << "无法写入: " << config.json << std::endl;
+            return;
+        }
+        out << "{\n  \"case\": " << jsonString(config.benchCase) << ",\n  \"timestamp\": " << std::time(nullptr)
+            << ",\n  \"config\": {\"rows\": " << config.rows << ", \"queries\": " << config.queries
+            << ", \"threads\": " << config.threads << ", \"inserts\": " << config.inserts << "},\n  \"results\": [";
+        for (size_t t = 0; t < results().size(); ++t)
+        {
+            const auto& table = results()[t];
+            out << (t ? "," : "") << "\n    {\"name\": " << jsonString(table.name) << ", \"rows\": [";
+            for (size_t r = 0; r < table.rows.size(); ++r)
+            {
+                out << (r ? "," : "") << "\n      {";
+                for (size_t c = 0; c < table.headers.size() && c < table.rows[r].size(); ++c)
+                {
+                    out << (c ? ", " : "") << jsonString(table.headers[c]) << ": " << jsonValue(table.rows[r][c]);
+                }
+                out << "}";
+            }
+            out << "\n    ]}";
+        }
+        out << "\n  ]\n}\n";
+    }
+
+    BenchConfig parseArgs(const int argc, char* argv[])
+    {
+        BenchConfig config;
+        for (int i = 1; i + 1 < argc; i += 2)
+        {
+            const std::string key = argv[i];
+            const std::string value = argv[i + 1];
+            if (key == "--case")
+                config.benchCase = value;
+            else if (key == "--db")
+                config.db = value;
+            else if (key == "--rows")
+                config.rows = std::stoi(value);
+            else if (key == "--queries")
+                config.queries = std::stoi(value);
+            else if (key == "--threads")
+                config.threads = std::stoi(value);
+            else if (key == "--inserts")
+                config.inserts = std::stoi(value);
+            else if (key == "--json")
+                config.json = value;
+            else
+                std::cerr << "未知参数: " << key << std::endl;
+        }
+        return config;
+    }
+
+    void removeDatabase(const std::string& path)
+    {
+        std::remove(path.c_str());
+        std::remove((path + "-wal").c_str());
+        std::remove((path + "-shm").c_str());
+    }
+
+    // 重新打开数据库,readerCount为只读连接数
+    jade::SqliteHelper& openDatabase(const BenchConfig& config, const int readerCount,
+                                     const jade::SqliteHelper::TuningProfile& profile = {})
+    {
+        auto& db = jade::SqliteHelper::getInstance();
+        db.close();
+        db.init(config.db.c_str(), profile, readerCount);
+        return db;
+    }
+
+    const char* const kInsertEvent = "INSERT INTO events (ts, camera, label, score) VALUES (?, ?, ?, ?);";
+
+    std::vector<jade::SqliteHelper::SQLiteValue> eventParams(const int i)
+    {
+        return {
+            static_cast<SqliteInt64>(1700000000000LL + i), static_cast<SqliteInt64>(i % 16),
+            std::string(i % 2 ? "person" : "car"), 0.5 + (i % 50) / 100.0
+        };
+    }
+
+    // 事件表,与业务中的逐帧检测事件结构一致
+    void createEventTable(const jade::SqliteHelper& db)
+    {
+        (void)db.execute("CREATE TABLE events (id INTEGER PRIMARY KEY, ts INTEGER NOT NULL, camera INTEGER NOT NULL,"
+            " label TEXT NOT NULL, score REAL NOT NULL, payload BLOB);");
+    }
+
+    void createEvents(const BenchConfig& config, const int rows, const jade::SqliteHelper::TuningProfile& profile = {})
+    {
+        jade::SqliteHelper::getInstance().close();
+        removeDatabase(config.db);
+        auto& db = openDatabase(config, 0, profile);
+        createEventTable(db);
+        jade::SqliteHelper::Transaction transaction(db);
+        for (int i = 0; i < rows; ++i)
+        {
+            (void)db.executeWithParams(kInsertEvent, eventParams(i));
+        }
+        transaction.commit();
+    }
+
+    // 多线程按主键点查询,返回每秒查询数
+    double runPointQueries(const BenchConfig& config, const int threadCount)
+    {
+        auto& db = jade::SqliteHelper::getInstance();
+        const int perThread = config.queries / threadCount;
+        std::atomic<int> failures{0};
+        const auto begin = std::chrono::steady_clock::now();
+        std::vector<std::thread> threads;
+        threads.reserve(threadCount);
+        for (int t = 0; t < threadCount; ++t)
+        {
+            threads.emplace_back([&, t]
+            {
+                std::mt19937 random(t);
+                std::uniform_int_distribution<int> ids(1, config.rows);
+                for (int i = 0; i < perThread; ++i)
+                {
+                    const auto rows = db.query("SELECT ts, camera, label, score FROM events WHERE id = ?;",
+                                               {static_cast<SqliteInt64>(ids(random))});
+                    if (rows.size() != 1)
+                        ++failures;
+                }
+            });
+        }
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+        const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+        if (failures > 0)
+        {
+            std::cerr << "查询失败次数: " << failures.load() << std::endl;
+        }
+        return static_cast<double>(perThread) * threadCount / seconds;
+    }
+
+    void benchRead(const BenchConfig& config)
+    {
+        createEvents(config, config.rows);
+        std::vector<std::vector<std::string>> rows;
+        for (int threads = 1; threads <= config.threads; threads *= 2)
+        {
+            openDatabase(config, 0);
+            const double single = runPointQueries(config, threads);
+            openDatabase(config, threads);
+            const double pooled = runPointQueries(config, threads);
+            rows.push_back({
+                std::to_string(threads), jade::formatValue(single, 0), jade::formatValue(pooled, 0),
+                jade::formatValue(pooled / single, 2)
+            });
+        }
+        report("read", {"线程数", "单连接QPS", "只读连接池QPS", "加速比"}, rows);
+    }
+
+    // 多个采集线程同时写入事件,返回每秒插入数和调用线程单次调用的平均耗时(us)
+    std::pair<double, double> runInserts(const BenchConfig& config, const bool async)
+    {
+        createEvents(config, 0);
+        auto& db = jade::SqliteHelper::getInstance();
+        const int perThread = config.inserts / config.threads;
+        std::atomic<int> failures{0};
+        std::atomic<int64_t> callerMicros{0};
+        const auto begin = std::chrono::steady_clock::now();
+        std::vector<std::thread> threads;
+        for (int t = 0; t < config.threads; ++t)
+        {
+            threads.emplace_back([&, t]
+            {
+                const auto callerBegin = std::chrono::steady_clock::now();
+                for (int i = 0; i < perThread; ++i)
+                {
+                    if (async)
+                    {
+                        db.executeAsync(kInsertEvent, eventParams(t * perThread + i), [&failures](const bool success)
+                        {
+                            if (!success)
+                                ++failures;
+                        });
+                    }
+                    else if (!db.executeWithParams(kInsertEvent, eventParams(t * perThread + i)))
+                    {
+                        ++failures;
+                    }
+                }
+                callerMicros += std::chrono::duration_cast<std::chrono::microseconds>(
+                    std::chrono::steady_clock::now() - callerBegin).count();
+            });
+        }
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+        // 停止写线程会等待队列中的请求全部写入
+        db.stopAsyncWriter();
+        const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+        if (failures > 0)
+        {
+            std::cerr << "插入失败次数: " << failures.load() << std::endl;
+        }
+        const double total = static_cast<double>(perThread) * config.threads;
+        return {total / seconds, static_cast<double>(callerMicros) / total};
+    }
+
+    void benchBulk(const BenchConfig& config)
+    {
+        std::vector<std::vector<jade::SqliteHelper::SQLiteValue>> events;
+        events.reserve(config.rows);
+        for (int i = 0; i < config.rows; ++i)
+        {
+            events.push_back(eventParams(i));
+        }
+        std::vector<std::vector<std::string>> rows;
+        const auto measure = [&](const std::string& name, const std::function<size_t()>& insert)
+        {
+            createEvents(config, 0);
+            const auto begin = std::chrono::steady_clock::now();
+            const size_t inserted = insert();
+            const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+            rows.push_back({
+                name, std::to_string(inserted), jade::formatValue(seconds * 1000, 1),
+                jade::formatValue(static_cast<double>(inserted) / seconds, 0)
+            });
+        };
+        auto& db = jade::SqliteHelper::getInstance();
+        measure("executeWithParams", [&]
+        {
+            size_t inserted = 0;
+            for (const auto& event : events)
+                inserted += db.executeWithParams(kInsertEvent, event);
+            return inserted;
+        });
+        measure("Transaction + executeWithParams", [&]
+        {
+            size_t inserted = 0;
+            jade::SqliteHelper::Transaction transaction(db);
+            for (const auto& event : events)
+                inserted += db.executeWithParams(kInsertEvent, event);
+            transaction.commit();
+            return inserted;
+        });
+        measure("executeBatch", [&]
+        {
+            return db.executeBatch(kInsertEvent, events).succeeded;
+        });
+        report("bulk", {"写入方式", "插入行数", "耗时(ms)", "插入/s"}, rows);
+    }
+
+    void benchParam(const BenchConfig& config)
+    {
+        createEvents(config, config.rows);
+        auto& db = openDatabase(config, 1);
+        std::vector<std::vector<std::string>> rows;
+        const auto measure = [&](const std::string& name, const std::function<size_t(SqliteInt64)>& lookup)
+        {
+            std::mt19937 random(0);
+            std::uniform_int_distribution<int> ids(1, config.rows);
+            size_t found = 0;
+            const auto begin = std::chrono::steady_clock::now();
+            for (int i = 0; i < config.queries; ++i)
+            {
+                found += lookup(ids(random));
+            }
+            const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+            const auto stats = db.getStatementCacheStats();
+            rows.push_back({
+                name, std::to_string(found), jade::formatValue(config.queries / seconds, 0),
+                jade::formatValue(seconds * 1e6 / config.queries, 2), std::to_string(stats.size)
+            });
+        };
+        measure("拼接SQL", [&](const SqliteInt64 id)
+        {
+            return db.query("SELECT ts, camera, label, score FROM events WHERE id = " + std::to_string(id) + ";").size();
+        });
+        measure("位置参数", [&](const SqliteInt64 id)
+        {
+            return db.query("SELECT ts, camera, label, score FROM events WHERE id = ?;", {id}).size();
+        });
+        measure("命名参数", [&](const SqliteInt64 id)
+        {
+            return db.query("SELECT ts, camera, label, score FROM events WHERE id = :id;",
+                            jade::SqliteHelper::NamedParams{{"id", id}}).size();
+        });
+        report("param", {"查询方式", "命中行数", "QPS", "单次耗时(us)", "缓存语句数"}, rows);
+    }
+
+    void benchProfile(const BenchConfig& config)
+    {
+        std::vector<std::vector<jade::SqliteHelper::SQLiteValue>> events;
+        events.reserve(config.rows);
+        for (int i = 0; i < config.rows; ++i)
+        {
+            events.push_back(eventParams(config.inserts + i));
+        }
+        const std::vector<std::pair<std::string, jade::SqliteHelper::TuningPreset>> presets = {
+            {"durable", jade::SqliteHelper::TuningPreset::DURABLE},
+            {"balanced", jade::SqliteHelper::TuningPreset::BALANCED},
+            {"throughput", jade::SqliteHelper::TuningPreset::THROUGHPUT}
+        };
+        std::vector<std::vector<std::string>> rows;
+        for (const auto& [name, preset] : presets)
+        {
+            const auto profile = jade::SqliteHelper::tuningProfile(preset);
+            createEvents(config, 0, profile);
+            auto& db = openDatabase(config, 1, profile);
+            // 逐条提交,每次提交的同步与checkpoint开销
+            auto begin = std::chrono::steady_clock::now();
+            for (int i = 0; i < config.inserts; ++i)
+            {
+                (void)db.executeWithParams(kInsertEvent, eventParams(i));
+            }
+            const double commitRate = config.inserts / std::chrono::duration<double>(
+                std::chrono::steady_clock::now() - begin).count();
+            begin = std::chrono::steady_clock::now();
+            const size_t inserted = db.executeBatch(kInsertEvent, events).succeeded;
+            const double batchRate = static_cast<double>(inserted) / std::chrono::duration<double>(
+                std::chrono::steady_clock::now() - begin).count();
+            const double qps = runPointQueries(config, 1);
+            std::error_code error;
+            const auto walBytes = fs::file_size(config.db + "-wal", error);
+            rows.push_back({
+                name, jade::formatValue(commitRate, 0), jade::formatValue(batchRate, 0), jade::formatValue(qps, 0),
+                jade::formatValue(error ? 0.0 : static_cast<double>(walBytes) / (1024 * 1024), 2)
+            });
+        }
+        report("profile", {"预设", "逐条提交/s", "批量插入/s", "点查询QPS", "WAL大小(MB)"}, rows);
+    }
+
+    // 每个线程写入databases[t % databases.size()],返回每秒插入数
+    double runParallelWrites(const BenchConfig& config, const std::vector<jade::SqliteHelper*>& databases)
+    {
+        const int perThread = config.inserts / config.threads;
+        std::atomic<int> failures{0};
+        const auto begin = std::chrono::steady_clock::now();
+        std::vector<std::thread> threads;
+        for (int t = 0; t < config.threads; ++t)
+        {
+            threads.emplace_back([&, t]
+            {
+                jade::SqliteHelper& db = *databases[t % databases.size()];
+                for (int i = 0; i < perThread; ++i)
+                {
+                    if (!db.executeWithParams(kInsertEvent, eventParams(t * perThread + i)))
+                        ++failures;
+                }
+            });
+        }
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+        const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+        if (failures > 0)
+        {
+            std::cerr << "插入失败次数: " << failures.load() << std::endl;
+        }
+        return static_cast<double>(perThread) * config.threads / seconds;
+    }
+
+    void benchMulti(const BenchConfig& config)
+    {
+        createEvents(config, 0);
+        const double shared = runParallelWrites(config, {&jade::SqliteHelper::getInstance()});
+        jade::SqliteHelper::getInstance().close();
+
+        std::vector<std::unique_ptr<jade::SqliteHelper>> instances;
+        std::vector<jade::SqliteHelper*> databases;
+        for (int t = 0; t < config.threads; ++t)
+        {
+            const std::string path = config.db + "." + std::to_string(t);
+            removeDatabase(path);
+            instances.push_back(std::make_unique<jade::SqliteHelper>());
+            instances.back()->init(path.c_str(), 0);
+            createEventTable(*instances.back());
+            databases.push_back(instances.back().get());
+        }
+        const double separate = runParallelWrites(config, databases);
+        instances.clear();
+        for (int t = 0; t < config.threads; ++t)
+        {
+            removeDatabase(config.db + "." + std::to_string(t));
+        }
+        report("multi", {"写入方式", "线程数", "插入/s", "加速比"}, {
+                                   {"单个数据库", std::to_string(config.threads), jade::formatValue(shared, 0), "1.00"},
+                                   {
+                                       "每线程独立实例", std::to_string(config.threads), jade::formatValue(separate, 0),
+                                       jade::formatValue(separate / shared, 2)
+                                   }
+                               });
+    }
+
+    void benchRetention(const BenchConfig& config)
+    {
+        constexpr int kDays = 7;
+        constexpr SqliteInt64 kDay = 24LL * 60 * 60 * 1000;
+        // EventStore按当前时间计算保留期, 事件分布在截止到现在的kDays天内
+        const SqliteInt64 now = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+        const SqliteInt64 start = (now / kDay - kDays + 1) * kDay;
+        const SqliteInt64 step = std::max<SqliteInt64>(1, (now - start) / std::max(1, config.rows));
+        std::vector<std::vector<jade::SqliteHelper::SQLiteValue>> events;
+        events.reserve(config.rows);
+        for (int i = 0; i < config.rows; ++i)
+        {
+            auto event = eventParams(i);
+            event[0] = start + i * step;
+            events.push_back(std::move(event));
+        }
+        const auto elapsedMs = [](const std::chrono::steady_clock::time_point begin)
+        {
+            return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+        };
+
+        const auto profile = jade::SqliteHelper::tuningProfile(jade::SqliteHelper::TuningPreset::BALANCED);
+        createEvents(config, 0, profile);
+        auto& db = jade::SqliteHelper::getInstance();
+        (void)db.execute("CREATE INDEX events_ts ON events (ts);");
+        auto begin = std::chrono::steady_clock::now();
+        (void)db.executeBatch(kInsertEvent, events);
+        const double tableInsert = elapsedMs(begin);
+        begin = std::chrono::steady_clock::now();
+        (void)db.executeWithParams("DELETE FROM events WHERE ts < ?;", {start + kDay});
+        const double tableDrop = elapsedMs(begin);
+        db.close();
+
+        const std::string directory = config.db + ".partitions";
+        jade::EventStore::Options options;
+        options.directory = directory;
+        options.columns = "camera INTEGER NOT NULL, label TEXT NOT NULL, score REAL NOT NULL";
+        options.retentionDays = kDays;
+        options.profile = profile;
+        double storeInsert = 0;
+        double storeDrop = 0;
+        {
+            jade::EventStore store(options);
+            begin = std::chrono::steady_clock::now();
+            (void)store.insertBatch(events);
+            storeInsert = elapsedMs(begin);
+            begin = std::chrono::steady_clock::now();
+            (void)store.dropExpired(start + kDay * kDays);
+            storeDrop = elapsedMs(begin);
+        }
+        fs::remove_all(directory);
+        report("retention", {"存储方式", "事件数", "插入耗时(ms)", "删除最早一天(ms)"}, {
+                                   {
+                                       "单表DELETE", std::to_string(config.rows), jade::formatValue(tableInsert, 1),
+                                       jade::formatValue(tableDrop, 1)
+                                   },
+                                   {
+                                       "EventStore", std::to_string(config.rows), jade::formatValue(storeInsert, 1),
+                                       jade::formatValue(storeDrop, 1)
+                                   }
+                               });
+    }
+
+    double percentile(const std::vector<double>& sorted, const double p)
+    {
+        if (sorted.empty())
+            return 0;
+        const auto index = std::min(sorted.size() - 1, static_cast<size_t>(p * static_cast<double>(sorted.size())));
+        return sorted[index];
+    }
+
+    // 一种操作的结果行: 操作, 次数, 每秒处理的行数, 单次操作的p50/p99/最大延迟(us)
+    std::vector<std::string> latencyRow(const std::string& name, std::vector<double> micros, const double seconds,
+                                        const size_t rowsPerOp = 1)
+    {
+        std::sort(micros.begin(), micros.end());
+        return {
+            name, std::to_string(micros.size()),
+            jade::formatValue(static_cast<double>(micros.size() * rowsPerOp) / seconds, 0),
+            jade::formatValue(percentile(micros, 0.50), 1), jade::formatValue(percentile(micros, 0.99), 1),
+            jade::formatValue(micros.empty() ? 0.0 : micros.back(), 1)
+        };
+    }
+
+    // 执行count次op,记录每次的耗时
+    std::vector<std::string> measureOps(const std::string& name, const int count, const std::function<void(int)>& op,
+                                        const size_t rowsPerOp = 1)
+    {
+        std::vector<double> micros;
+        micros.reserve(count);
+        const auto begin = std::chrono::steady_clock::now();
+        for (int i = 0; i < count; ++i)
+        {
+            const auto opBegin = std::chrono::steady_clock::now();
+            op(i);
+            micros.push_back(std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - opBegin).count());
+        }
+        const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+        return latencyRow(name, std::move(micros), seconds, rowsPerOp);
+    }
+
+    void benchSuite(const BenchConfig& config)
+    {
+        constexpr int kBatchSize = 1000;
+        constexpr int kScanRows = 1000;
+        const char* const kPointQuery = "SELECT ts, camera, label, score FROM events WHERE id = ?;";
+        std::vector<std::vector<std::string>> rows;
+        std::mt19937 random(0);
+        std::uniform_int_distribution<int> ids(1, config.rows);
+
+        createEvents(config, 0);
+        auto& db = openDatabase(config, config.threads);
+        rows.push_back(measureOps("单条插入", config.inserts, [&](const int i)
+        {
+            (void)db.executeWithParams(kInsertEvent, eventParams(i));
+        }));
+        std::vector<std::vector<jade::SqliteHelper::SQLiteValue>> batch(kBatchSize);
+        rows.push_back(measureOps("批量插入", config.rows / kBatchSize, [&](const int b)
+        {
+            for (int i = 0; i < kBatchSize; ++i)
+                batch[i] = eventParams(config.inserts + b * kBatchSize + i);
+            (void)db.executeBatch(kInsertEvent, batch);
+        }, kBatchSize));
+        rows.push_back(measureOps("点查询", config.queries, [&](int)
+        {
+            (void)db.query(kPointQuery, {static_cast<SqliteInt64>(ids(random))});
+        }));
+        std::uniform_int_distribution<int> starts(1, std::max(1, config.rows - kScanRows));
+        rows.push_back(measureOps("范围扫描", std::max(1, config.queries / 100), [&](int)
+        {
+            const SqliteInt64 first = starts(random);
+            db.queryEach("SELECT ts, camera, label, score FROM events WHERE id BETWEEN ? AND ?;",
+                         {first, first + kScanRows - 1}, [](const jade::SqliteHelper::Row& row)
+                         {
+                             return row.getDouble(3) >= 0;
+                         });
+        }, kScanRows));
+
+        // threads个读线程持续点查询,同时一个写线程逐条插入,直到读线程完成queries次查询
+        std::atomic<bool> reading{true};
+        std::vector<std::vector<double>> readMicros(config.threads);
+        std::vector<double> writeMicros;
+        const auto begin = std::chrono::steady_clock::now();
+        std::thread writer([&]
+        {
+            for (int i = 0; reading; ++i)
+            {
+                const auto opBegin = std::chrono::steady_clock::now();
+                (void)db.executeWithParams(kInsertEvent, eventParams(config.inserts + config.rows + i));
+                writeMicros.push_back(
+                    std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - opBegin).count());
+            }
+        });
+        std::vector<std::thread> readers;
+        for (int t = 0; t < config.threads; ++t)
+        {
+            readers.emplace_back([&, t]
+            {
+                std::mt19937 threadRandom(t + 1);
+                for (int i = 0; i < config.queries / config.threads; ++i)
+                {
+                    const auto opBegin = std::chrono::steady_clock::now();
+                    (void)db.query(kPointQuery, {static_cast<SqliteInt64>(ids(threadRandom))});
+                    readMicros[t].push_back(
+                        std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - opBegin).count());
+                }
+            });
+        }
+        for (auto& reader : readers)
+        {
+            reader.join();
+        }
+        reading = false;
+        writer.join();
+        const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+        std::vector<double> allReads;
+        for (const auto& micros : readMicros)
+            allReads.insert(allReads.end(), micros.begin(), micros.end());
+        rows.push_back(latencyRow("并发读(" + std::to_string(config.threads) + "线程)", std::move(allReads), seconds));
+        rows.push_back(latencyRow("并发写(1线程)", std::move(writeMicros), seconds));
+        report("suite", {"操作", "次数", "行/s", "p50(us)", "p99(us)", "max(us)"}, rows);
+    }
+
+    void benchAsync(const BenchConfig& config)
+    {
+        const auto [syncRate, syncCall] = runInserts(config, false);
+        const auto [asyncRate, asyncCall] = runInserts(config, true);
+        report("async", {"写入方式", "线程数", "插入/s", "调用耗时(us)"}, {
+                                   {
+                                       "executeWithParams", std::to_string(config.threads),
+                                       jade::formatValue(syncRate, 0), jade::formatValue(syncCall, 1)
+                                   },
+                                   {
+                                       "executeAsync", std::to_string(config.threads), jade::formatValue(asyncRate, 0),
+                                       jade::formatValue(asyncCall, 1)
+                                   }
+                               });
+    }
+}
+
+int main(const int argc, char* argv[])
+{
+    const BenchConfig config = parseArgs(argc, argv);
+    jade::Logger::getInstance().init("bench_sqlite", "bench", "Logs", jade::Logger::S_WARNING, true, false);
+    if (config.benchCase == "suite")
+    {
+        benchSuite(config);
+    }
+    else if (config.benchCase == "read")
+    {
+        benchRead(config);
+    }
+    else if (config.benchCase == "async")
+    {
+        benchAsync(config);
+    }
+    else if (config.benchCase == "bulk")
+    {
+        benchBulk(config);
+    }
+    else if (config.benchCase == "param")
+    {
+        benchParam(config);
+    }
+    else if (config.benchCase == "profile")
+    {
+        benchProfile(config);
+    }
+    else if (config.benchCase == "multi")
+    {
+        benchMulti(config);
+    }
+    else if (config.benchCase == "retention")
+    {
+        benchRetention(config);
+    }
+    else
+    {
+        std::cerr << "未知测试: " << config.benchCase << std::endl;
+    }
+    if (!config.json.empty())
+    {
+        writeJson(config);
+    }
+    jade::SqliteHelper::getInstance().close();
+    removeDatabase(config.db);
+    jade::Logger::getInstance().shutDown();
+    return 0;
+}
@@ -0,0 +1,177 @@
+/**
+# @File     : bench_xml.cpp
+# @Author   : jade
+# @Date     : 2026/10/19 23:40
+# @Email    : jadehh@1ive.com
+# @Software : Samples
+# @Desc     : XmlReader 与 INIReader 加载相机清单的性能对比
+#
+# 用法: bench_xml [--cameras 100000] [--lookups 1000] [--file bench_xml]
+#   生成 100, 1000, ... cameras 台相机的清单, 同样的内容分别写成INI(每台相机一个节)和XML(每台相机一个camera元素),
+#   测量两种格式的加载耗时、读取全部相机字段的耗时,以及按名称查找单台相机的耗时
+*/
+#include "include/jade_tools.h"
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+    struct BenchConfig
+    {
+        int cameras = 100000;
+        int lookups = 1000;
+        std::string file = "bench_xml";
+    };
+
+    BenchConfig parseArgs(const int argc, char* argv[])
+    {
+        BenchConfig config;
+        for (int i = 1; i + 1 < argc; i += 2)
+        {
+            const std::string key = argv[i];
+            const std::string value = argv[i + 1];
+            if (key == "--cameras")
+                config.cameras = std::stoi(value);
+            else if (key == "--lookups")
+                config.lookups = std::stoi(value);
+            else if (key == "--file")
+                config.file = value;
+            else
+                std::cerr << "未知参数: " << key << std::endl;
+        }
+        return config;
+    }
+
+    std::string cameraName(const int index)
+    {
+        return "Camera" + std::to_string(index);
+    }
+
+    std::string cameraIp(const int index)
+    {
+        return "10." + std::to_string(index / 65536 % 256) + "." + std::to_string(index / 256 % 256) + "." +
+            std::to_string(index % 256);
+    }
+
+    // 写入cameras台相机的INI和XML清单,返回两个文件的大小
+    std::pair<size_t, size_t> writeInventory(const BenchConfig& config, const int cameras)
+    {
+        std::ofstream ini(config.file + ".ini", std::ios::binary | std::ios::trunc);
+        std::ofstream xml(config.file + ".xml", std::ios::binary | std::ios::trunc);
+        xml << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n<inventory>\n";
+        for (int i = 0; i < cameras; ++i)
+        {
+            const std::string type = i % 2 == 0 ? "hikvision" : "dahua";
+            ini << "[" << cameraName(i) << "]\n"
+                << "ip = " << cameraIp(i) << "\nuser = admin\npassword = admin123\nport = " << 554 + i % 10
+                << "\npath = /Streaming/Channels/101\ntype = " << type << "\nuse_gpu = " << (i % 3 == 0)
+                << "\nframe_interval = " << 1 + i % 5 << "\n";
+            xml << "  <camera name=\"" << cameraName(i) << "\" ip=\"" << cameraIp(i) << "\" type=\"" << type << "\">\n"
+                << "    <user>admin</user>\n    <password>admin123</password>\n    <port>" << 554 + i % 10
+                << "</port>\n    <path>/Streaming/Channels/101</path>\n    <use_gpu>" << (i % 3 == 0)
+                << "</use_gpu>\n    <frame_interval>" << 1 + i % 5 << "</frame_interval>\n  </camera>\n";
+        }
+        xml << "</inventory>\n";
+        return {static_cast<size_t>(ini.tellp()), static_cast<size_t>(xml.tellp())};
+    }
+
+    double elapsedMs(const std::chrono::steady_clock::time_point begin)
+    {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+    }
+}
+
+int main(const int argc, char* argv[])
+{
+    const BenchConfig config = parseArgs(argc, argv);
+    jade::Logger::getInstance().init("bench_xml", "bench", "Logs", jade::Logger::S_WARNING, true, false);
+    std::vector<std::vector<std::string>> rows;
+    jade::XmlReader xml;
+    for (int cameras = 100; cameras <= config.cameras; cameras *= 10)
+    {
+        const auto [iniBytes, xmlBytes] = writeInventory(config, cameras);
+
+        auto begin = std::chrono::steady_clock::now();
+        const jade::INIReader ini(config.file + ".ini");
+        const double iniLoadMs = elapsedMs(begin);
+        // 同一个XmlReader反复加载,复用缓冲区和内存池
+        begin = std::chrono::steady_clock::now();
+        if (!xml.load(config.file + ".xml"))
+        {
+            std::cerr << "解析失败: " << xml.error() << std::endl;
+        }
+        const double xmlLoadMs = elapsedMs(begin);
+
+        // 读取每台相机的全部字段,与生成RtspInfo列表的过程一致
+        long iniSum = 0;
+        begin = std::chrono::steady_clock::now();
+        for (const std::string& section : ini.Sections())
+        {
+            iniSum += static_cast<long>(ini.Get(section, "ip", "").size() + ini.Get(section, "user", "").size() +
+                ini.Get(section, "password", "").size() + ini.Get(section, "path", "").size() +
+                ini.Get(section, "type", "").size()) + ini.GetInteger(section, "port", 554) +
+                ini.GetBoolean(section, "use_gpu", false) + ini.GetInteger(section, "frame_interval", 5);
+        }
+        const double iniScanMs = elapsedMs(begin);
+        long xmlSum = 0;
+        begin = std::chrono::steady_clock::now();
+        for (const jade::XmlReader::Node& camera : xml.select("/inventory/camera"))
+        {
+            xmlSum += static_cast<long>(camera.attribute("ip").value_or("").size() +
+                camera.value("user").value_or("").size() + camera.value("password").value_or("").size() +
+                camera.value("path").value_or("").size() + camera.attribute("type").value_or("").size()) +
+                camera.get("port", 554) + camera.get("use_gpu", false) + camera.get("frame_interval", 5);
+        }
+        const double xmlScanMs = elapsedMs(begin);
+        if (iniSum != xmlSum)
+        {
+            std::cerr << "两种格式读取的结果不一致: " << iniSum << " != " << xmlSum << std::endl;
+        }
+
+        // 按名称随机查找相机的ip
+        std::mt19937 random(0);
+        std::uniform_int_distribution<int> index(0, cameras - 1);
+        const int lookups = std::max(1, config.lookups);
+        size_t iniFound = 0;
+        begin = std::chrono::steady_clock::now();
+        for (int i = 0; i < lookups; ++i)
+        {
+            iniFound += !ini.Get(cameraName(index(random)), "ip", "").empty();
+        }
+        const double iniLookupMs = elapsedMs(begin);
+        random.seed(0);
+        size_t xmlFound = 0;
+        begin = std::chrono::steady_clock::now();
+        for (int i = 0; i < lookups; ++i)
+        {
+            xmlFound += xml.value("/inventory/camera[@name='" + cameraName(index(random)) + "']/@ip").has_value();
+        }
+        const double xmlLookupMs = elapsedMs(begin);
+        if (iniFound != xmlFound)
+        {
+            std::cerr << "查找结果不一致: " << iniFound << " != " << xmlFound << std::endl;
+        }
+
+        rows.push_back({
+            std::to_string(cameras), jade::formatValue(static_cast<double>(iniBytes) / (1024 * 1024)),
+            jade::formatValue(static_cast<double>(xmlBytes) / (1024 * 1024)),
+            jade::formatValue(iniLoadMs, 2), jade::formatValue(xmlLoadMs, 2),
+            jade::formatValue(iniScanMs, 2), jade::formatValue(xmlScanMs, 2),
+            jade::formatValue(iniLookupMs * 1e3 / lookups, 2), jade::formatValue(xmlLookupMs * 1e3 / lookups, 2),
+            std::to_string(xmlSum)
+        });
+    }
+    jade::printPrettyTable({
+                               "相机数", "INI大小(MB)", "XML大小(MB)", "INI加载(ms)", "XML加载(ms)", "INI遍历(ms)",
+                               "XML遍历(ms)", "INI查找(us)", "XML查找(us)", "校验和"
+                           }, rows);
+    std::remove((config.file + ".ini").c_str());
+    std::remove((config.file + ".xml").c_str());
+    jade::Logger::getInstance().shutDown();
+    return 0;
+}
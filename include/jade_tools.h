@@ -12,9 +12,20 @@
 
 // 跨平台导出宏
 #include <chrono>
+#include <cstdint>
 #include <functional>
+#include <future>
+#include <limits>
 #include <map>
+#include <memory>
+#include <optional>
 #include <set>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
 #include <variant>
 #include <vector>
 #include <bitset>
@@ -513,6 +524,152 @@ namespace jade
         CryptoUtilImpl* crypto_util_impl_;
     };
 
+    namespace detail
+    {
+        // 可以转换为任意类型,用于在编译期推导聚合类型的成员数量
+        struct AnyField
+        {
+            template <typename T>
+            operator T() const;
+        };
+
+        template <typename T, typename Indices, typename = void>
+        struct IsBraceConstructible : std::false_type
+        {
+        };
+
+        template <typename T, size_t... I>
+        struct IsBraceConstructible<T, std::index_sequence<I...>,
+                                    std::void_t<decltype(T{(void(I), AnyField{})...})>> : std::true_type
+        {
+        };
+
+        template <typename T>
+        struct IsTuple : std::false_type
+        {
+        };
+
+        template <typename... Args>
+        struct IsTuple<std::tuple<Args...>> : std::true_type
+        {
+        };
+
+        template <typename T>
+        struct IsOptional : std::false_type
+        {
+        };
+
+        template <typename T>
+        struct IsOptional<std::optional<T>> : std::true_type
+        {
+        };
+
+        template <typename T>
+        inline constexpr bool AlwaysFalse = false;
+
+        // 聚合类型的成员数量(最多16个),tuple为元素数量
+        template <typename T, size_t N = 16>
+        constexpr size_t fieldCount()
+        {
+            if constexpr (IsTuple<T>::value)
+                return std::tuple_size_v<T>;
+            else if constexpr (N == 0)
+                return 0;
+            else if constexpr (IsBraceConstructible<T, std::make_index_sequence<N>>::value)
+                return N;
+            else
+                return fieldCount<T, N - 1>();
+        }
+
+        // 将聚合类型的成员按声明顺序绑定为引用tuple
+        template <typename T>
+        auto tieFields(T& value)
+        {
+            constexpr size_t count = fieldCount<T>();
+            static_assert(count > 0 && count <= 16, "聚合类型的成员数量必须在1到16之间");
+            if constexpr (count == 1)
+            {
+                auto& [a] = value;
+                return std::tie(a);
+            }
+            else if constexpr (count == 2)
+            {
+                auto& [a, b] = value;
+                return std::tie(a, b);
+            }
+            else if constexpr (count == 3)
+            {
+                auto& [a, b, c] = value;
+                return std::tie(a, b, c);
+            }
+            else if constexpr (count == 4)
+            {
+                auto& [a, b, c, d] = value;
+                return std::tie(a, b, c, d);
+            }
+            else if constexpr (count == 5)
+            {
+                auto& [a, b, c, d, e] = value;
+                return std::tie(a, b, c, d, e);
+            }
+            else if constexpr (count == 6)
+            {
+                auto& [a, b, c, d, e, f] = value;
+                return std::tie(a, b, c, d, e, f);
+            }
+            else if constexpr (count == 7)
+            {
+                auto& [a, b, c, d, e, f, g] = value;
+                return std::tie(a, b, c, d, e, f, g);
+            }
+            else if constexpr (count == 8)
+            {
+                auto& [a, b, c, d, e, f, g, h] = value;
+                return std::tie(a, b, c, d, e, f, g, h);
+            }
+            else if constexpr (count == 9)
+            {
+                auto& [a, b, c, d, e, f, g, h, i] = value;
+                return std::tie(a, b, c, d, e, f, g, h, i);
+            }
+            else if constexpr (count == 10)
+            {
+                auto& [a, b, c, d, e, f, g, h, i, j] = value;
+                return std::tie(a, b, c, d, e, f, g, h, i, j);
+            }
+            else if constexpr (count == 11)
+            {
+                auto& [a, b, c, d, e, f, g, h, i, j, k] = value;
+                return std::tie(a, b, c, d, e, f, g, h, i, j, k);
+            }
+            else if constexpr (count == 12)
+            {
+                auto& [a, b, c, d, e, f, g, h, i, j, k, l] = value;
+                return std::tie(a, b, c, d, e, f, g, h, i, j, k, l);
+            }
+            else if constexpr (count == 13)
+            {
+                auto& [a, b, c, d, e, f, g, h, i, j, k, l, m] = value;
+                return std::tie(a, b, c, d, e, f, g, h, i, j, k, l, m);
+            }
+            else if constexpr (count == 14)
+            {
+                auto& [a, b, c, d, e, f, g, h, i, j, k, l, m, n] = value;
+                return std::tie(a, b, c, d, e, f, g, h, i, j, k, l, m, n);
+            }
+            else if constexpr (count == 15)
+            {
+                auto& [a, b, c, d, e, f, g, h, i, j, k, l, m, n, o] = value;
+                return std::tie(a, b, c, d, e, f, g, h, i, j, k, l, m, n, o);
+            }
+            else
+            {
+                auto& [a, b, c, d, e, f, g, h, i, j, k, l, m, n, o, p] = value;
+                return std::tie(a, b, c, d, e, f, g, h, i, j, k, l, m, n, o, p);
+            }
+        }
+    }
+
     /**
     * Sqlite 帮助类
     */
@@ -529,7 +686,9 @@ namespace jade
             std::vector<uint8_t> // 对应SQLite的BLOB
         >;
 
-        // 事务处理（线程安全）
+        // 事务处理（线程安全）: 事务属于创建它的线程,最外层事务独占写连接直到提交或回滚,
+        // 其他线程的写操作等待其结束、读操作不受影响;同一线程内嵌套的Transaction对应SAVEPOINT。
+        // 事务期间不要等待executeAsync的结果,异步写线程需要等事务结束才能写入
         class JADE_API Transaction
         {
         public:
@@ -542,20 +701,270 @@ namespace jade
             bool committed;
         };
 
+        // BLOB列视图,指向sqlite内部缓冲区
+        struct BlobView
+        {
+            const uint8_t* data = nullptr;
+            size_t size = 0;
+        };
+
+        // 查询结果中的一行,只在遍历回调期间有效;按列下标访问,TEXT/BLOB不拷贝
+        class JADE_API Row
+        {
+        public:
+            [[nodiscard]] int columnCount() const;
+            [[nodiscard]] const char* columnName(int index) const;
+            [[nodiscard]] bool isNull(int index) const;
+            [[nodiscard]] SqliteInt64 getInt64(int index) const;
+            [[nodiscard]] double getDouble(int index) const;
+            [[nodiscard]] std::string_view getText(int index) const;
+            [[nodiscard]] BlobView getBlob(int index) const;
+            [[nodiscard]] SQLiteValue getValue(int index) const;
+
+            // 按列类型读取: 整数/枚举/bool、浮点、std::string、std::vector<uint8_t>、SQLiteValue及其std::optional
+            template <typename T>
+            void read(const int index, T& value) const
+            {
+                if constexpr (detail::IsOptional<T>::value)
+                {
+                    if (isNull(index))
+                    {
+                        value.reset();
+                        return;
+                    }
+                    typename T::value_type inner{};
+                    read(index, inner);
+                    value = std::move(inner);
+                }
+                else if constexpr (std::is_same_v<T, bool>)
+                    value = getInt64(index) != 0;
+                else if constexpr (std::is_integral_v<T> || std::is_enum_v<T>)
+                    value = static_cast<T>(getInt64(index));
+                else if constexpr (std::is_floating_point_v<T>)
+                    value = static_cast<T>(getDouble(index));
+                else if constexpr (std::is_same_v<T, std::string>)
+                    value.assign(getText(index));
+                else if constexpr (std::is_same_v<T, std::vector<uint8_t>>)
+                {
+                    const BlobView blob = getBlob(index);
+                    value.assign(blob.data, blob.data + blob.size);
+                }
+                else if constexpr (std::is_same_v<T, SQLiteValue>)
+                    value = getValue(index);
+                else
+                    static_assert(detail::AlwaysFalse<T>, "不支持的列类型");
+            }
+
+            // 按位置把各列依次写入tuple的元素或聚合类型的成员
+            template <typename T>
+            void readInto(T& value) const
+            {
+                const auto readAll = [this](auto&... fields)
+                {
+                    int index = 0;
+                    (read(index++, fields), ...);
+                };
+                if constexpr (detail::IsTuple<T>::value)
+                    std::apply(readAll, value);
+                else
+                    std::apply(readAll, detail::tieFields(value));
+            }
+
+        private:
+            friend class SqliteHelper;
+            explicit Row(void* stmt): stmt_(stmt)
+            {
+            }
+
+            void* stmt_; // sqlite3_stmt
+        };
+
+        // 行回调,返回false时停止遍历
+        using RowVisitor = std::function<bool(const Row& row)>;
+        // 命名参数,键为SQL中的参数名(:id、@id、$id),也可以省略前缀。
+        // 只能用{{名称, 值}, ...}初始化,避免与位置参数的花括号初始化产生歧义
+        struct NamedParams
+        {
+            NamedParams() = default;
+
+            NamedParams(const std::initializer_list<std::pair<const std::string, SQLiteValue>> init) : values(init)
+            {
+            }
+
+            std::map<std::string, SQLiteValue> values;
+        };
+
+        // 每个实例拥有独立的写连接、只读连接和异步写线程,不同数据库之间互不阻塞
+        SqliteHelper();
+        ~SqliteHelper();
         // 删除复制构造函数和赋值运算符
         SqliteHelper(const SqliteHelper&) = delete;
         SqliteHelper& operator=(const SqliteHelper&) = delete;
+        // 默认实例,程序退出时自动close(停止异步写和checkpoint线程),也可以提前调用close
         static SqliteHelper& getInstance();
-        void init(const char* dbPath);
+        // 按名称获取实例,第一次获取时创建,之后返回同一个实例;与getInstance()的默认实例相互独立
+        static SqliteHelper& getInstance(const std::string& name);
+
+        // 连接调优参数,对应sqlite的PRAGMA设置,默认值与sqlite的默认值一致
+        struct TuningProfile
+        {
+            enum class Synchronous { OFF = 0, NORMAL = 1, FULL = 2, EXTRA = 3 };
+
+            enum class TempStore { DEFAULT = 0, FILE = 1, MEMORY = 2 };
+
+            Synchronous synchronous = Synchronous::FULL; // WAL模式下NORMAL只在掉电时可能丢失最近提交的事务
+            int cacheSizeKb = 2000; // 每个连接的页缓存大小
+            int64_t mmapSize = 0; // 内存映射读取的字节数,0为关闭
+            TempStore tempStore = TempStore::DEFAULT;
+            int pageSize = 4096; // 只在新建数据库时生效
+            int busyTimeoutMs = 0; // 数据库被其他进程锁定时的等待时间
+            int walAutoCheckpoint = 1000; // WAL达到多少页时由提交的事务执行checkpoint,0为关闭
+            int checkpointIntervalMs = 0; // 大于0时由后台线程按此间隔执行checkpoint,不占用提交的时间
+            int64_t journalSizeLimit = -1; // checkpoint后WAL文件保留的最大字节数,-1为不限制
+        };
+
+        // 预设的调优参数
+        enum class TuningPreset
+        {
+            DURABLE, // 每次提交都同步到磁盘,提交时checkpoint
+            BALANCED, // 掉电时可能丢失最近的提交但不会损坏数据库,较大的缓存和内存映射
+            THROUGHPUT // 在BALANCED基础上关闭提交时的checkpoint,由后台线程checkpoint
+        };
+
+        [[nodiscard]] static TuningProfile tuningProfile(TuningPreset preset);
+        // 打开数据库: 一个写连接执行写操作和事务,readerCount个只读连接并发执行查询(内存数据库不使用只读连接)
+        void init(const char* dbPath, int readerCount = 4);
+        void init(const char* dbPath, const TuningProfile& profile, int readerCount = 4);
         // 创建数据库连接（使用智能指针管理）
         [[nodiscard]] std::vector<std::map<std::string, SQLiteValue>> query(const std::string& sql) const;
+        // 参数化查询,语句可以被缓存复用,不需要拼接SQL
+        [[nodiscard]] std::vector<std::map<std::string, SQLiteValue>> query(
+            const std::string& sql, const std::vector<SQLiteValue>& params) const;
+        [[nodiscard]] std::vector<std::map<std::string, SQLiteValue>> query(
+            const std::string& sql, const NamedParams& params) const;
+        // 逐行遍历查询结果,内存占用与结果集大小无关,返回遍历的行数;回调期间占用一个数据库连接。
+        // 回调中可以再次查询或写入同一个SqliteHelper(复用已占用的连接),但不要开启事务
+        size_t queryEach(const std::string& sql, const RowVisitor& visitor) const;
+        size_t queryEach(const std::string& sql, const std::vector<SQLiteValue>& params,
+                         const RowVisitor& visitor) const;
+        size_t queryEach(const std::string& sql, const NamedParams& params, const RowVisitor& visitor) const;
+
+        // 按列的位置映射到tuple或聚合类型(如 struct Event { SqliteInt64 id; std::string label; double score; }),
+        // 不经过SQLiteValue和列名查找;结果按该语句上一次的行数预分配
+        template <typename T, typename Params = std::vector<SQLiteValue>>
+        [[nodiscard]] std::vector<T> query(const std::string& sql, const Params& params = Params()) const
+        {
+            static_assert(detail::IsTuple<T>::value || std::is_aggregate_v<T>, "T必须是std::tuple或聚合类型");
+            std::vector<T> results;
+            bool checked = false;
+            visitRows(sql, params, [&](const Row& row)
+            {
+                if (!checked)
+                {
+                    if (static_cast<size_t>(row.columnCount()) != detail::fieldCount<T>())
+                    {
+                        throw std::runtime_error("查询结果的列数与类型的成员数量不一致: " + sql);
+                    }
+                    checked = true;
+                }
+                results.emplace_back();
+                row.readInto(results.back());
+                return true;
+            }, [&results](const size_t estimate) { results.reserve(estimate); });
+            return results;
+        }
         // 执行SQL命令（线程安全）
         [[nodiscard]] bool execute(const std::string& sql) const;
         [[nodiscard]] bool executeWithParams(const std::string& sql, const std::vector<SQLiteValue>& params) const;
+        [[nodiscard]] bool executeWithParams(const std::string& sql, const NamedParams& params) const;
+
+        // 批量写入结果,committed为false时所有行都未写入
+        struct BatchResult
+        {
+            bool committed = false;
+            size_t succeeded = 0;
+            std::vector<size_t> failedRows; // 执行失败的行下标
+        };
+
+        // 同一条语句批量写入多行: 只编译一次,在一个事务中逐行绑定执行
+        [[nodiscard]] BatchResult executeBatch(const std::string& sql,
+                                               const std::vector<std::vector<SQLiteValue>>& rows) const;
+
+        // 异步批量写入: 写请求进入无锁队列,由后台线程按数量或时间窗口合并到一个事务中执行
+        struct AsyncWriteOptions
+        {
+            size_t maxBatchSize = 1000; // 单个事务最多包含的写请求数
+            int maxDelayMs = 5; // 收到第一个请求后最多等待多久以攒满一批
+        };
+
+        using WriteCallback = std::function<void(bool success)>;
+        // 启动异步写线程,未调用时首次executeAsync会以默认配置启动
+        void startAsyncWriter(const AsyncWriteOptions& options) const;
+        // 停止异步写线程,返回前执行完队列中已有的请求;之后的executeAsync直接返回失败,直到再次startAsyncWriter
+        void stopAsyncWriter() const;
+        // 调用线程不会等待数据库,结果通过future或回调(在写线程中执行)返回
+        [[nodiscard]] std::future<bool> executeAsync(const std::string& sql, std::vector<SQLiteValue> params) const;
+        void executeAsync(const std::string& sql, std::vector<SQLiteValue> params, WriteCallback callback) const;
+
+        // 预编译语句缓存统计
+        struct StatementCacheStats
+        {
+            uint64_t hits = 0;
+            uint64_t misses = 0;
+            size_t size = 0; // 所有连接当前缓存的语句数
+            size_t capacity = 0; // 每个连接的缓存容量
+        };
+
+        [[nodiscard]] StatementCacheStats getStatementCacheStats() const;
+        // 设置预编译语句缓存容量(默认64),为0时关闭缓存
+        void setStatementCacheSize(size_t capacity) const;
         void close() ;
 
     private:
-        SqliteHelper();
+        size_t visitRows(const std::string& sql, const std::vector<SQLiteValue>& params, const RowVisitor& visitor,
+                         const std::function<void(size_t)>& reserve) const;
+        size_t visitRows(const std::string& sql, const NamedParams& params, const RowVisitor& visitor,
+                         const std::function<void(size_t)>& reserve) const;
+        class Impl;
+        Impl* impl_;
+    };
+
+    /**
+    * 按天分区的事件存储, 每天的事件写入独立的数据库文件, 过期的分区直接删除文件
+    */
+    class JADE_API EventStore
+    {
+    public:
+        struct Options
+        {
+            std::string directory = "."; // 分区文件所在目录
+            std::string name = "events"; // 表名和文件名前缀, 分区文件为<name>_YYYYMMDD.db
+            std::string columns; // ts之外的列定义, 如 "camera INTEGER, label TEXT, score REAL"
+            int retentionDays = 7; // 保留的天数(含当天), 0为不自动删除
+            int utcOffsetMinutes = 0; // 按本地时间划分天, 如东八区为480
+            int futureToleranceMinutes = 10; // 事件时间最多超前当前时间的分钟数, 超出的事件拒绝写入
+            int readerCount = 1; // 每个分区的只读连接数
+            SqliteHelper::TuningProfile profile = SqliteHelper::tuningProfile(SqliteHelper::TuningPreset::BALANCED);
+        };
+
+        explicit EventStore(const Options& options);
+        ~EventStore();
+        EventStore(const EventStore&) = delete;
+        EventStore& operator=(const EventStore&) = delete;
+
+        // 写入一条事件, row[0]为毫秒时间戳, 其余按columns的顺序; 按当前时间判断过期, 跨天时自动删除过期分区
+        [[nodiscard]] bool insert(const std::vector<SqliteHelper::SQLiteValue>& row) const;
+        // 批量写入, 按分区分组后每个分区一个事务, 返回成功写入的行数
+        [[nodiscard]] size_t insertBatch(const std::vector<std::vector<SqliteHelper::SQLiteValue>>& rows) const;
+        // 按时间顺序遍历[begin, end)内的事件, where为附加条件, params为where中的参数, 返回遍历的行数
+        size_t query(SqliteInt64 begin, SqliteInt64 end, const SqliteHelper::RowVisitor& visitor,
+                     const std::string& where = "", const std::vector<SqliteHelper::SQLiteValue>& params = {}) const;
+        // 删除now所在天往前retentionDays天之前的分区, 返回删除的分区数
+        size_t dropExpired(SqliteInt64 now) const;
+        // 当前所有分区的文件路径, 按日期排序
+        [[nodiscard]] std::vector<std::string> partitions() const;
+
+    private:
         class Impl;
         Impl* impl_;
     };
@@ -590,66 +999,580 @@ namespace jade
     class JADE_API INIReader
     {
     public:
+        // 预先查找好的键,由key()获取,按键读取时不再构造和查找键名;只在创建它的INIReader上有效
+        class Key
+        {
+        public:
+            Key() = default;
+            // 键存在时为true,不存在时按键读取都返回默认值
+            [[nodiscard]] bool valid() const { return slot_ != npos; }
+
+        private:
+            friend class INIReader;
+            static constexpr uint32_t npos = UINT32_MAX;
+            explicit Key(const uint32_t slot) : slot_(slot) {}
+            uint32_t slot_ = npos;
+        };
+
         // Empty Constructor
         INIReader();
 
-        // Construct INIReader and parse given filename. See ini.h for more info
-        // about the parsing.
+        // Construct INIReader and parse given filename. The file is read into
+        // memory once and there is no limit on the line length.
         explicit INIReader(const std::string& filename);
 
-        // Construct INIReader and parse given file. See ini.h for more info
-        // about the parsing.
+        // Construct INIReader and parse given file. The content is read into
+        // memory once, parsing follows the same rules as the filename version.
         [[maybe_unused]] [[maybe_unused]] explicit INIReader(FILE* file);
 
-        // Return the result of ini_parse(), i.e., 0 on success, line number of
+        // 解析内存中的配置内容,内容会被拷贝一份,调用后data可以释放
+        INIReader(const char* data, size_t size);
+
+        ~INIReader();
+        INIReader(const INIReader&) = delete;
+        INIReader& operator=(const INIReader&) = delete;
+
+        // Return the parse result, i.e., 0 on success, line number of
         // first error on parse error, or -1 on file open error.
         [[nodiscard]] int ParseError() const;
 
         // Return the list of sections found in ini file
         [[nodiscard]] const std::set<std::string>& Sections() const;
 
+        // 按类型读取,值不存在或不是有效的该类型时返回std::nullopt,不打印日志
+        [[nodiscard]] std::optional<std::string> TryGet(const std::string& section, const std::string& name) const;
+        [[nodiscard]] std::optional<long> TryGetInteger(const std::string& section, const std::string& name) const;
+        [[nodiscard]] std::optional<double> TryGetReal(const std::string& section, const std::string& name) const;
+        [[nodiscard]] std::optional<float> TryGetFloat(const std::string& section, const std::string& name) const;
+        [[nodiscard]] std::optional<bool> TryGetBoolean(const std::string& section, const std::string& name) const;
+        // 按GetInteger、GetReal、GetFloat和GetBoolean的规则转换文本,不是有效的该类型时返回std::nullopt;
+        // 不是从INI文件读取的值(如ConfigCache中的XML)用它们保持同样的转换规则
+        [[nodiscard]] static std::optional<long> ParseInteger(const std::string& text);
+        [[nodiscard]] static std::optional<double> ParseReal(const std::string& text);
+        [[nodiscard]] static std::optional<float> ParseFloat(const std::string& text);
+        [[nodiscard]] static std::optional<bool> ParseBoolean(const std::string& text);
+
+        // 节内的所有键名(保持文件中的写法),按键名排序(不区分大小写)
+        [[nodiscard]] std::vector<std::string> Keys(const std::string& section) const;
+
+        // 与other相比新增、删除或有值变化的节(节名和键名不区分大小写)
+        [[nodiscard]] std::set<std::string> ChangedSections(const INIReader& other) const;
+
+        // 查找键,键不存在时打印一次警告并返回无效的Key;
+        // 值在加载时已按整数、浮点数和布尔值解析,按Key读取为O(1)且不分配内存(Get除外),
+        // 适合每帧读取配置的场景。按Key读取时值不存在或类型不符直接返回默认值,不打印日志
+        [[nodiscard]] Key key(const std::string& section, const std::string& name) const;
 
         // Get a string value from INI file, returning default_value if not found.
         [[nodiscard]] std::string Get(const std::string& section, const std::string& name,
                                       const std::string& default_value) const;
+        [[nodiscard]] std::string Get(const Key& key, const std::string& default_value) const;
 
         // Get an integer (long) value from INI file, returning default_value if
         // not found or not a valid integer (decimal "1234", "-1234", or hex "0x4d2").
         [[nodiscard]] long GetInteger(const std::string& section, const std::string& name, long default_value) const;
+        [[nodiscard]] long GetInteger(const Key& key, long default_value) const;
 
+        // 节内以prefix开头的键(不区分大小写)的值,按键名排序;值在加载时已解析,查询只在有序的键名中做范围查找,
+        // 不是有效数值的值记为0
         [[nodiscard]] std::vector<long> GetIntegerWithPrefix(const std::string& section,const std::string& prefix) const;
+        [[nodiscard]] std::vector<double> GetRealWithPrefix(const std::string& section, const std::string& prefix) const;
+        [[nodiscard]] std::vector<std::string> GetStringWithPrefix(const std::string& section, const std::string& prefix) const;
 
         // Get a real (floating point double) value from INI file, returning
         // default_value if not found or not a valid floating point value
         // according to str to d().
         [[nodiscard]] double GetReal(const std::string& section, const std::string& name, double default_value) const;
+        [[nodiscard]] double GetReal(const Key& key, double default_value) const;
 
         // Get a single precision floating point number value from INI file, returning
         // default_value if not found or not a valid floating point value
         // according to str to f().
         [[maybe_unused]] [[nodiscard]] float GetFloat(const std::string& section, const std::string& name, float default_value) const;
+        [[nodiscard]] float GetFloat(const Key& key, float default_value) const;
 
         // Get a boolean value from INI file, returning default_value if not found or
         // if not a valid true/false value. Valid true values are "true", "yes", "on",
         // "1", and valid false values are "false", "no", "off", "0" (not case-sensitive).
         [[nodiscard]] bool GetBoolean(const std::string& section, const std::string& name, bool default_value) const;
+        [[nodiscard]] bool GetBoolean(const Key& key, bool default_value) const;
 
     protected:
         class Impl;
         Impl* impl_;;
     };
 
+    /** ini配置结构绑定
+     * ######################################INISchema###################################
+     * 用字段描述声明配置结构,一次读取并校验所有字段,缺失和无效的键一起报告:
+     *   struct CameraConfig { long fps; double threshold; std::string url; };
+     *   static constexpr auto schema = jade::makeINISchema(
+     *       jade::iniField("camera", "fps", &CameraConfig::fps, 25).between(1, 120),
+     *       jade::iniField("camera", "threshold", &CameraConfig::threshold, 0.5).between(0.0, 1.0),
+     *       jade::iniField("camera", "url", &CameraConfig::url)); // 没有默认值的是必填项
+     *   CameraConfig config{};
+     *   std::vector<std::string> errors;
+     *   if (!schema.load(reader, config, errors)) { ... }
+     */
+    template <typename Config, typename T>
+    struct INIField
+    {
+        static_assert(std::is_same_v<T, std::string> || std::is_arithmetic_v<T>,
+                      "INIField只支持std::string、bool、整数和浮点数类型的字段");
+        // 字符串字段的默认值使用const char*,使字段描述可以是constexpr
+        using Value = std::conditional_t<std::is_same_v<T, std::string>, const char*, T>;
+
+        const char* section;
+        const char* name;
+        T Config::* member;
+        std::optional<Value> defaultValue; // 为空时是必填项
+        std::optional<Value> low;
+        std::optional<Value> high;
+
+        // 限制取值范围[lowest, highest]
+        [[nodiscard]] constexpr INIField between(const Value lowest, const Value highest) const
+        {
+            static_assert(std::is_arithmetic_v<T>, "只有数值字段可以限制取值范围");
+            INIField field = *this;
+            field.low = lowest;
+            field.high = highest;
+            return field;
+        }
+
+        // 读取字段,出错时使用默认值(如果有)并把错误追加到errors
+        void load(const INIReader& reader, Config& config, std::vector<std::string>& errors) const
+        {
+            const std::string key = std::string("[") + section + "] " + name + ": ";
+            const std::optional<std::string> text = reader.TryGet(section, name);
+            if (!text)
+            {
+                if (defaultValue)
+                    config.*member = T(*defaultValue);
+                else
+                    errors.push_back(key + "缺少必填项");
+                return;
+            }
+            const std::optional<T> value = parse(reader);
+            if (!value)
+            {
+                errors.push_back(key + "不是有效的" + typeName() + ": " + *text);
+            }
+            else if ((low && *value < *low) || (high && *value > *high))
+            {
+                errors.push_back(key + "超出范围[" + format(*low) + ", " + format(*high) + "]: " + *text);
+            }
+            else
+            {
+                config.*member = *value;
+                return;
+            }
+            if (defaultValue)
+                config.*member = T(*defaultValue);
+        }
+
+    private:
+        [[nodiscard]] std::optional<T> parse(const INIReader& reader) const
+        {
+            if constexpr (std::is_same_v<T, std::string>)
+            {
+                return reader.TryGet(section, name);
+            }
+            else if constexpr (std::is_same_v<T, bool>)
+            {
+                return reader.TryGetBoolean(section, name);
+            }
+            else if constexpr (std::is_integral_v<T>)
+            {
+                // 超出字段类型范围的整数视为无效
+                const std::optional<long> value = reader.TryGetInteger(section, name);
+                if (!value)
+                    return std::nullopt;
+                if constexpr (std::is_signed_v<T>)
+                {
+                    if (*value < (std::numeric_limits<T>::min)() || *value > (std::numeric_limits<T>::max)())
+                        return std::nullopt;
+                }
+                else if (*value < 0 || static_cast<unsigned long>(*value) > (std::numeric_limits<T>::max)())
+                {
+                    return std::nullopt;
+                }
+                return static_cast<T>(*value);
+            }
+            else if constexpr (std::is_same_v<T, float>)
+            {
+                return reader.TryGetFloat(section, name);
+            }
+            else
+            {
+                const std::optional<double> value = reader.TryGetReal(section, name);
+                return value ? std::optional<T>(static_cast<T>(*value)) : std::nullopt;
+            }
+        }
+
+        static std::string typeName()
+        {
+            if constexpr (std::is_same_v<T, std::string>)
+                return "字符串";
+            else if constexpr (std::is_same_v<T, bool>)
+                return "布尔值";
+            else if constexpr (std::is_integral_v<T>)
+                return "整数";
+            else
+                return "浮点数";
+        }
+
+        static std::string format(const Value value)
+        {
+            if constexpr (std::is_floating_point_v<Value>)
+                return formatValue(static_cast<double>(value), 6, false);
+            else if constexpr (std::is_arithmetic_v<Value>)
+                return std::to_string(value);
+            else
+                return value;
+        }
+    };
+
+    // 必填字段
+    template <typename Config, typename T>
+    constexpr INIField<Config, T> iniField(const char* section, const char* name, T Config::* member)
+    {
+        return {section, name, member, std::nullopt, std::nullopt, std::nullopt};
+    }
+
+    // 带默认值的字段,键不存在时使用默认值
+    template <typename Config, typename T>
+    constexpr INIField<Config, T> iniField(const char* section, const char* name, T Config::* member,
+                                           const std::common_type_t<typename INIField<Config, T>::Value>& defaultValue)
+    {
+        return {section, name, member, defaultValue, std::nullopt, std::nullopt};
+    }
+
+    template <typename Config, typename... Fields>
+    class INISchema
+    {
+    public:
+        constexpr explicit INISchema(const Fields&... fields) : fields_(fields...)
+        {
+        }
+
+        // 按字段描述读取所有字段,所有缺失和无效的键都追加到errors,全部有效时返回true
+        bool load(const INIReader& reader, Config& config, std::vector<std::string>& errors) const
+        {
+            const size_t count = errors.size();
+            std::apply([&](const auto&... field) { (field.load(reader, config, errors), ...); }, fields_);
+            return errors.size() == count;
+        }
+
+        [[nodiscard]] static constexpr size_t size()
+        {
+            return sizeof...(Fields);
+        }
+
+    private:
+        std::tuple<Fields...> fields_;
+    };
+
+    template <typename Config, typename... T>
+    constexpr INISchema<Config, INIField<Config, T>...> makeINISchema(const INIField<Config, T>&... fields)
+    {
+        return INISchema<Config, INIField<Config, T>...>(fields...);
+    }
+
+    /** ini配置热加载
+     * ######################################INIWatcher###################################
+     */
+    class JADE_API INIWatcher
+    {
+    public:
+        using Snapshot = std::shared_ptr<const INIReader>;
+        // 节变化的回调: section为新增、修改或删除的节名,previous和current为变化前后的配置
+        using SectionCallback = std::function<void(const std::string& section, const Snapshot& previous,
+                                                   const Snapshot& current)>;
+
+        // 加载filename并在后台监听文件变化,Linux下使用inotify,其他平台每pollIntervalMs毫秒检查一次修改时间;
+        // 文件变化后解析为新的快照并原子替换,解析失败时保留当前配置
+        explicit INIWatcher(const std::string& filename, int pollIntervalMs = 1000);
+        ~INIWatcher();
+        INIWatcher(const INIWatcher&) = delete;
+        INIWatcher& operator=(const INIWatcher&) = delete;
+
+        // 当前配置,读取不需要加锁;持有的快照内容不会改变,INIReader::Key只在获取它的快照上有效
+        [[nodiscard]] Snapshot snapshot() const;
+        // 注册节变化的回调,section为空时任意节变化都会回调;回调在执行重新加载的线程中执行,
+        // 回调中可以调用reload和stop,但不能析构INIWatcher
+        void onSectionChanged(const std::string& section, const SectionCallback& callback) const;
+        // 立即重新加载,发布了新的配置时返回true;解析失败或内容没有变化时返回false
+        bool reload() const;
+        // 停止监听,之后仍可以调用snapshot和reload
+        void stop() const;
+
+    private:
+        class Impl;
+        Impl* impl_;
+    };
+
+    /** 配置二进制缓存
+     * ######################################ConfigCache###################################
+     * 把解析后的INI或XML配置编译为带版本号和校验和的二进制缓存: 字符串表、哈希索引和加载时解析好的数值。
+     * 启动时映射缓存文件,按源文件的修改时间和大小校验,不一致时再比较内容哈希;缓存失效时完整解析源文件并重新生成。
+     * XML按元素路径展开为节: 同名的兄弟元素带从1开始的下标(如inventory/camera[2]),没有子元素的元素以元素名为键、
+     * 文本为值,属性以"@属性名"为键。INI的节名和键名不区分大小写,XML区分
+     */
+    class JADE_API ConfigCache
+    {
+    public:
+        enum class Format
+        {
+            INI,
+            XML
+        };
+
+        ConfigCache();
+        ~ConfigCache();
+        ConfigCache(const ConfigCache&) = delete;
+        ConfigCache& operator=(const ConfigCache&) = delete;
+
+        // 加载source,cachePath为空时使用source + ".cache";缓存有效时直接映射缓存文件,否则解析source并重新生成缓存,
+        // 缓存写入失败时使用内存中的编译结果。源文件不存在时使用结构完整的缓存;都不可用或XML解析失败时返回false,
+        // INI中无法解析的行与INIReader一样只打印警告
+        bool open(const std::string& source, Format format, const std::string& cachePath = "");
+        // 解析source并生成缓存文件(先写临时文件再重命名),用于部署前预先生成缓存
+        static bool compile(const std::string& source, Format format, const std::string& cachePath);
+
+        // 本次open是否直接使用了缓存文件
+        [[nodiscard]] bool fromCache() const;
+        [[nodiscard]] size_t size() const;
+
+        // 值在ConfigCache重新open或析构前有效
+        [[nodiscard]] std::optional<std::string_view> Find(const std::string& section, const std::string& name) const;
+        // 与INIReader的同名接口一致,值不存在或无效时打印警告并返回默认值
+        [[nodiscard]] std::string Get(const std::string& section, const std::string& name,
+                                      const std::string& default_value) const;
+        [[nodiscard]] long GetInteger(const std::string& section, const std::string& name, long default_value) const;
+        [[nodiscard]] double GetReal(const std::string& section, const std::string& name, double default_value) const;
+        [[nodiscard]] float GetFloat(const std::string& section, const std::string& name, float default_value) const;
+        [[nodiscard]] bool GetBoolean(const std::string& section, const std::string& name, bool default_value) const;
+        // 按生成缓存时的顺序遍历所有的值(INI按节名和键名排序,XML按文档顺序)
+        void forEach(const std::function<void(std::string_view section, std::string_view name,
+                                              std::string_view value)>& visitor) const;
+
+    private:
+        class Impl;
+        Impl* impl_;
+    };
+
+    /** XML配置读取
+     * ######################################XmlReader###################################
+     * 基于rapidxml的原位解析: 文件一次读入缓冲区后直接在缓冲区上解析,元素名、文本和属性都指向缓冲区,
+     * 节点从文档的内存池中分配,重新加载时复用内存池。路径语法(XPath的子集):
+     *   /inventory/camera      从根元素开始的绝对路径,不以/开头时相对于当前节点
+     *   //camera               任意层级的camera元素
+     *   camera[2]              第2个camera子元素(从1开始)
+     *   camera[@type='hik']    type属性为hik的camera, [@type]表示有type属性
+     *   camera[ip='10.0.0.1']  子元素ip的文本为10.0.0.1的camera
+     *   *                      任意名称的元素
+     *   camera/@name           value和get中,最后一级可以是属性
+     * 元素名和属性名区分大小写
+     */
+    class JADE_API XmlReader
+    {
+    public:
+        // 文档中的一个元素,在XmlReader重新加载或析构前有效
+        class JADE_API Node
+        {
+        public:
+            Node() = default;
+            explicit operator bool() const { return node_ != nullptr; }
+            [[nodiscard]] std::string_view name() const;
+            [[nodiscard]] std::string_view text() const;
+            [[nodiscard]] std::optional<std::string_view> attribute(std::string_view name) const;
+            // 按路径选出所有匹配的元素,按文档顺序
+            [[nodiscard]] std::vector<Node> select(const std::string& path) const;
+            // 第一个匹配的元素,没有时为空节点
+            [[nodiscard]] Node first(const std::string& path) const;
+            // 第一个匹配的元素的文本,路径的最后一级为@name时是属性值
+            [[nodiscard]] std::optional<std::string_view> value(const std::string& path) const;
+
+            // 按类型读取value(path),支持std::string、bool、整数和浮点数,不存在、无效或超出T的范围时返回default_value;
+            // 数值和布尔值按INIReader::Parse*转换
+            template <typename T>
+            [[nodiscard]] T get(const std::string& path, const T& default_value) const
+            {
+                static_assert(std::is_same_v<T, std::string> || std::is_arithmetic_v<T>,
+                              "XmlReader::get只支持std::string、bool、整数和浮点数");
+                const std::optional<std::string_view> view = value(path);
+                if (!view)
+                    return default_value;
+                const std::string text(*view);
+                if constexpr (std::is_same_v<T, std::string>)
+                {
+                    return text;
+                }
+                else if constexpr (std::is_same_v<T, bool>)
+                {
+                    return INIReader::ParseBoolean(text).value_or(default_value);
+                }
+                else if constexpr (std::is_integral_v<T>)
+                {
+                    // 与INIField一致,超出类型范围的整数视为无效
+                    const std::optional<long> number = INIReader::ParseInteger(text);
+                    if (!number)
+                        return default_value;
+                    if constexpr (std::is_signed_v<T>)
+                    {
+                        if (*number < (std::numeric_limits<T>::min)() || *number > (std::numeric_limits<T>::max)())
+                            return default_value;
+                    }
+                    else if (*number < 0 || static_cast<unsigned long>(*number) > (std::numeric_limits<T>::max)())
+                    {
+                        return default_value;
+                    }
+                    return static_cast<T>(*number);
+                }
+                else if constexpr (std::is_same_v<T, float>)
+                {
+                    return INIReader::ParseFloat(text).value_or(default_value);
+                }
+                else
+                {
+                    const std::optional<double> number = INIReader::ParseReal(text);
+                    return number ? static_cast<T>(*number) : default_value;
+                }
+            }
+
+        private:
+            friend class XmlReader;
+            explicit Node(const void* node) : node_(node) {}
+            const void* node_ = nullptr;
+        };
+
+        XmlReader();
+        // 读取并解析filename,失败时error()返回原因
+        explicit XmlReader(const std::string& filename);
+        ~XmlReader();
+        XmlReader(const XmlReader&) = delete;
+        XmlReader& operator=(const XmlReader&) = delete;
+
+        // 重新加载,之前取得的Node全部失效
+        bool load(const std::string& filename);
+        // 解析内存中的XML,内容会被拷贝一份,调用后data可以释放
+        bool parse(const char* data, size_t size);
+        // 最近一次加载的错误信息,成功时为空
+        [[nodiscard]] const std::string& error() const;
+
+        // 文档节点,根元素是它的子元素
+        [[nodiscard]] Node document() const;
+        [[nodiscard]] Node root() const;
+        [[nodiscard]] std::vector<Node> select(const std::string& path) const;
+        [[nodiscard]] Node first(const std::string& path) const;
+        [[nodiscard]] std::optional<std::string_view> value(const std::string& path) const;
+
+        template <typename T>
+        [[nodiscard]] T get(const std::string& path, const T& default_value) const
+        {
+            return document().get(path, default_value);
+        }
+
+    private:
+        class Impl;
+        Impl* impl_;
+    };
+
     /** SocketServer
      * ######################################SocketServer###################################
      */
 
     class JADE_API SocketServer
     {
-        using MessageHandler = std::function<void(SOCKET_TYPE, char* ,size_t)>;
     public:
+        // 对端地址,ip为主机字节序,可通过getIntAsIp转换为字符串
+        struct PeerAddress
+        {
+            uint32_t ip = 0;
+            uint16_t port = 0;
+        };
+
+        using MessageHandler = std::function<void(SOCKET_TYPE, char* ,size_t)>;
+        // 带对端地址的消息回调,UDP模式下用于获取数据报的来源
+        using PeerMessageHandler = std::function<void(SOCKET_TYPE, char*, size_t, const PeerAddress&)>;
+
+        enum class Transport
+        {
+            TCP,
+            UDP // 数据报模式,每个数据报回调一次
+        };
+
+        // TCP消息分帧方式
+        enum class Framing
+        {
+            NONE, // 不分帧,连接关闭时将收到的全部数据作为一条消息回调
+            LENGTH_PREFIXED // 4字节大端长度头 + 消息体,每个完整帧回调一次,send时自动添加长度头
+        };
+
+        // 连接管理参数, 0 表示不启用/不限制
+        struct Options
+        {
+            Transport transport = Transport::TCP;
+            Framing framing = Framing::NONE;
+            size_t maxMessageSize = 0; // 单条消息最大长度,超出计为分帧错误并断开连接
+            int readIdleTimeoutMs = 0; // 读空闲超时(毫秒),超过该时间未收到数据则断开连接
+            int writeTimeoutMs = 0; // 写超时(毫秒),单次send阻塞超过该时间则断开连接
+            size_t maxConnections = 0; // 最大连接数,超出时拒绝新连接
+            size_t maxConnectionsPerIp = 0; // 单个IP的最大连接数
+            int udpSocketCount = 1; // UDP接收socket数量,大于1时使用SO_REUSEPORT分摊到多个线程
+            int udpBatchSize = 64; // 每次recvmmsg最多接收的数据报数量
+            int udpDatagramSize = 2048; // 单个数据报缓冲区大小,超出部分被截断
+            int receiveBufferBytes = 0; // SO_RCVBUF大小,0表示使用系统默认值
+        };
+
         SocketServer(int port,const MessageHandler& handler);
+        SocketServer(int port,const MessageHandler& handler, const Options& options);
+        SocketServer(int port, const PeerMessageHandler& handler, const Options& options);
+        ~SocketServer();
+        SocketServer(const SocketServer&) = delete;
+        SocketServer& operator=(const SocketServer&) = delete;
         void start() const;
-        void stop() ;
+        // 停止服务: 不再接受新连接,等待已接收的消息处理完成、发送完毕后回收所有线程,
+        // 超过timeoutMs(毫秒)仍未结束的连接会被强制关闭;停止后可以再次调用start。
+        // Framing::NONE时客户端尚未关闭连接的数据不是完整消息,会被丢弃而不回调
+        void stop(int timeoutMs = 3000);
+        [[nodiscard]] bool isRunning() const;
+        // 向客户端发送数据(受写超时控制),全部发送成功返回true
+        [[nodiscard]] bool send(SOCKET_TYPE client, const char* data, size_t size) const;
+        // UDP模式下向指定地址发送数据报
+        [[nodiscard]] bool sendTo(SOCKET_TYPE socket, const PeerAddress& peer, const char* data, size_t size) const;
+
+        // 单个连接的统计
+        struct ConnectionStats
+        {
+            uint64_t id = 0;
+            SOCKET_TYPE socket{};
+            PeerAddress peer;
+            uint64_t bytesIn = 0;
+            uint64_t bytesOut = 0;
+            uint64_t messagesIn = 0;
+            uint64_t messagesOut = 0;
+            double lastRttMs = 0; // 最近一次请求/响应往返时间,即收到消息到该连接下一次发送完成
+            double avgRttMs = 0;
+        };
+
+        // 服务统计,计数器按连接/接收线程各自累加,读取时汇总
+        struct Stats
+        {
+            uint64_t activeConnections = 0;
+            uint64_t totalConnections = 0; // 累计接受的连接数
+            uint64_t rejectedConnections = 0; // 因连接数限制被拒绝的连接数
+            int64_t timestampMs = 0; // 统计时刻(单调时钟,毫秒),两次统计的totalConnections之差除以时间差即为接受速率
+            uint64_t bytesIn = 0;
+            uint64_t bytesOut = 0;
+            uint64_t messagesIn = 0;
+            uint64_t messagesOut = 0;
+            uint64_t framingErrors = 0; // 长度超限、帧不完整、UDP数据报被截断
+            uint64_t activeHandlers = 0; // 正在执行的回调数量
+            std::vector<ConnectionStats> connections; // 仅在withConnections为true时填充
+        };
+
+        [[nodiscard]] Stats getStats(bool withConnections = false) const;
     private:
         class Impl;
         Impl* impl_;
@@ -771,6 +1694,9 @@ namespace jade
             [[maybe_unused]] [[maybe_unused]] [[nodiscard]] bool isValid() const;
             // 清空所有信息
             void clear() const;
+            // 按路径选出的每个元素生成一个RtspInfo,字段取同名属性或子元素: name、user、password、ip、port、path、
+            // use_gpu、frame_interval、type,如<camera name="gate" ip="10.0.0.1"><type>hik</type></camera>
+            static std::vector<RtspInfo> fromXml(const XmlReader& reader, const std::string& path = "//camera");
         private:
             class Impl;
             Impl* impl_;
@@ -839,6 +1765,8 @@ namespace jade
 #endif
         static MultiRtspManager& getInstance();
         void addStream(const RtspVideoCapture::RtspInfo& rtsp_info) const;
+        // 停止并移除ip地址为ip_address的流,配置热加载时只需重建变化的相机
+        bool removeStream(const std::string& ip_address) const;
         void stopAll();
         // 禁止拷贝和赋值
         MultiRtspManager(const MultiRtspManager&) = delete;
@@ -860,6 +1788,8 @@ namespace jade
 
 #define LOG_WARN() jade::LoggerStream(jade::Logger::Level::S_WARNING,__FILE__,__LINE__)
 #define DLL_LOG_WARN(module) jade::DLLLoggerStream(jade::Logger::Level::S_WARNING, __FILE__, __LINE__,module)
+// 配置的值不存在或无效时的警告,INIReader和ConfigCache共用
+#define DLL_LOG_CONFIG_WARN(module,section,name,default_value)  DLL_LOG_WARN(module) << "节点名:\"" << (section) << "\"" << ",字段名: \"" << (name) << "\",读取异常,请检查配置文件,使用默认值:" << (default_value);
 
 
 #define LOG_ERROR() jade::LoggerStream(jade::Logger::Level::S_ERROR,__FILE__,__LINE__)
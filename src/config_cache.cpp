@@ -0,0 +1,790 @@
+/**
+# @File     : config_cache.cpp
+# @Author   : jade
+# @Date     : 2026/10/19 22:10
+# @Email    : jadehh@1ive.com
+# @Software : Samples
+# @Desc     : 配置二进制缓存
+*/
+#include "include/jade_tools.h"
+#include "include/rapidxml.hpp"
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <unordered_map>
+#include <unordered_set>
+#ifdef LOW_GCC
+#include <experimental/filesystem>
+namespace fs = std::experimental::filesystem;
+#else
+#include <filesystem>
+namespace fs = std::filesystem;
+#endif
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+#define MODULE_NAME "ConfigCache"
+
+using namespace jade;
+
+namespace
+{
+    constexpr char kMagic[8] = {'J', 'A', 'D', 'E', 'C', 'F', 'G', '\0'};
+    constexpr uint32_t kVersion = 2;
+    constexpr uint32_t kByteOrder = 0x01020304; // 按本机字节序写入,读取时不一致说明缓存来自其他平台
+    constexpr uint32_t kNone = UINT32_MAX;
+
+    // 缓存布局: CacheHeader | CacheEntry[entryCount] | uint32_t[bucketCount] | 字符串表
+    struct CacheHeader
+    {
+        char magic[8];
+        uint32_t version;
+        uint32_t byteOrder;
+        uint32_t format;
+        uint32_t entryCount;
+        uint32_t bucketCount;
+        uint32_t reserved;
+        uint64_t sourceSize;
+        int64_t sourceTime;
+        uint64_t sourceHash;
+        uint64_t entriesOffset;
+        uint64_t bucketsOffset;
+        uint64_t stringsOffset;
+        uint64_t stringsSize;
+        uint64_t totalSize;
+        uint64_t checksum; // 头部之后全部内容的哈希
+    };
+
+    enum EntryFlags : uint32_t
+    {
+        INTEGER = 1,
+        REAL = 2,
+        BOOLEAN = 4,
+        TRUE_VALUE = 8,
+        FLOAT = 16
+    };
+
+    // 字符串为字符串表中的偏移和长度;next为同一个哈希桶中的下一项
+    struct CacheEntry
+    {
+        uint32_t section;
+        uint32_t sectionSize;
+        uint32_t name;
+        uint32_t nameSize;
+        uint32_t value;
+        uint32_t valueSize;
+        uint32_t next;
+        uint32_t flags;
+        float single;
+        uint32_t reserved;
+        int64_t integer;
+        double real;
+    };
+
+    // 值按各类型转换的结果,由INIReader的TryGet*或Parse*得到,与INIReader的转换规则一致
+    struct TypedValue
+    {
+        std::optional<long> integer;
+        std::optional<double> real;
+        std::optional<float> single;
+        std::optional<bool> boolean;
+    };
+
+    static_assert(sizeof(CacheHeader) % 8 == 0 && sizeof(CacheEntry) % 8 == 0, "缓存中的结构需要8字节对齐");
+
+    // 校验和与源文件哈希,按8字节处理,不用于安全校验
+    uint64_t hashBytes(const char* data, const size_t size)
+    {
+        uint64_t hash = 14695981039346656037ULL ^ size;
+        size_t i = 0;
+        for (; i + 8 <= size; i += 8)
+        {
+            uint64_t word;
+            std::memcpy(&word, data + i, sizeof(word));
+            hash = (hash ^ word) * 1099511628211ULL;
+            hash ^= hash >> 29;
+        }
+        for (; i < size; ++i)
+        {
+            hash = (hash ^ static_cast<unsigned char>(data[i])) * 1099511628211ULL;
+        }
+        return hash ^ (hash >> 32);
+    }
+
+    inline char fold(const char c, const bool ignoreCase)
+    {
+        return ignoreCase && c >= 'A' && c <= 'Z' ? static_cast<char>(c - 'A' + 'a') : c;
+    }
+
+    uint64_t hashKey(const std::string_view section, const std::string_view name, const bool ignoreCase)
+    {
+        uint64_t hash = 14695981039346656037ULL;
+        const auto mix = [&](const std::string_view text)
+        {
+            for (const char c : text)
+            {
+                hash ^= static_cast<unsigned char>(fold(c, ignoreCase));
+                hash *= 1099511628211ULL;
+            }
+        };
+        mix(section);
+        hash ^= '=';
+        hash *= 1099511628211ULL;
+        mix(name);
+        return hash;
+    }
+
+    bool equals(const std::string_view a, const std::string_view b, const bool ignoreCase)
+    {
+        if (a.size() != b.size())
+            return false;
+        for (size_t i = 0; i < a.size(); ++i)
+        {
+            if (fold(a[i], ignoreCase) != fold(b[i], ignoreCase))
+                return false;
+        }
+        return true;
+    }
+
+    bool readFile(const std::string& path, std::string& content)
+    {
+        std::error_code error;
+        if (!fs::is_regular_file(path, error))
+            return false;
+        FILE* file = fopen(path.c_str(), "rb");
+        if (!file)
+            return false;
+        content.clear();
+        char chunk[64 * 1024];
+        size_t n;
+        while ((n = fread(chunk, 1, sizeof(chunk), file)) > 0)
+            content.append(chunk, n);
+        const bool ok = ferror(file) == 0;
+        fclose(file);
+        return ok;
+    }
+
+    // 源文件的大小和修改时间
+    struct SourceStamp
+    {
+        bool exists = false;
+        uint64_t size = 0;
+        int64_t time = 0;
+    };
+
+    SourceStamp stampOf(const std::string& path)
+    {
+        SourceStamp stamp;
+        std::error_code error;
+        const auto size = fs::file_size(path, error);
+        if (error)
+            return stamp;
+        const auto time = fs::last_write_time(path, error);
+        if (error)
+            return stamp;
+        stamp.exists = true;
+        stamp.size = size;
+        stamp.time = static_cast<int64_t>(time.time_since_epoch().count());
+        return stamp;
+    }
+
+    // 缓存文件只会被整体替换(写临时文件后重命名),映射期间内容不会改变
+    class MappedFile
+    {
+    public:
+        MappedFile() = default;
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        ~MappedFile()
+        {
+            unmap();
+        }
+
+        bool map(const std::string& path)
+        {
+            unmap();
+#ifdef _WIN32
+            file_ = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE, nullptr,
+                                OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+            if (file_ == INVALID_HANDLE_VALUE)
+                return false;
+            LARGE_INTEGER size;
+            if (!GetFileSizeEx(file_, &size) || size.QuadPart == 0)
+            {
+                unmap();
+                return false;
+            }
+            size_ = static_cast<size_t>(size.QuadPart);
+            mapping_ = CreateFileMappingA(file_, nullptr, PAGE_READONLY, 0, 0, nullptr);
+            data_ = mapping_ ? static_cast<const char*>(MapViewOfFile(mapping_, FILE_MAP_READ, 0, 0, 0)) : nullptr;
+#else
+            const int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+            if (fd < 0)
+                return false;
+            struct stat info{};
+            if (fstat(fd, &info) == 0 && S_ISREG(info.st_mode) && info.st_size > 0)
+            {
+                size_ = static_cast<size_t>(info.st_size);
+                void* data = mmap(nullptr, size_, PROT_READ, MAP_SHARED, fd, 0);
+                data_ = data == MAP_FAILED ? nullptr : static_cast<const char*>(data);
+            }
+            ::close(fd);
+#endif
+            if (!data_)
+            {
+                unmap();
+                return false;
+            }
+            return true;
+        }
+
+        void unmap()
+        {
+#ifdef _WIN32
+            if (data_)
+                UnmapViewOfFile(data_);
+            if (mapping_)
+                CloseHandle(mapping_);
+            if (file_ != INVALID_HANDLE_VALUE)
+                CloseHandle(file_);
+            mapping_ = nullptr;
+            file_ = INVALID_HANDLE_VALUE;
+#else
+            if (data_)
+                munmap(const_cast<char*>(data_), size_);
+#endif
+            data_ = nullptr;
+            size_ = 0;
+        }
+
+        [[nodiscard]] const char* data() const
+        {
+            return data_;
+        }
+
+        [[nodiscard]] size_t size() const
+        {
+            return size_;
+        }
+
+    private:
+        const char* data_ = nullptr;
+        size_t size_ = 0;
+#ifdef _WIN32
+        HANDLE file_ = INVALID_HANDLE_VALUE;
+        HANDLE mapping_ = nullptr;
+#endif
+    };
+
+    // 按添加的顺序生成缓存内容
+    class CacheBuilder
+    {
+    public:
+        explicit CacheBuilder(const bool ignoreCase) : ignoreCase_(ignoreCase)
+        {
+        }
+
+        void add(const std::string_view section, const std::string_view name, const std::string_view value,
+                 const TypedValue& typed)
+        {
+            CacheEntry entry{};
+            // 同一节的键共用节名字符串
+            auto [it, inserted] = sections_.try_emplace(std::string(section), 0);
+            if (inserted)
+            {
+                it->second = append(section);
+            }
+            entry.section = it->second;
+            entry.sectionSize = static_cast<uint32_t>(section.size());
+            entry.name = append(name);
+            entry.nameSize = static_cast<uint32_t>(name.size());
+            entry.value = append(value);
+            entry.valueSize = static_cast<uint32_t>(value.size());
+            if (typed.integer)
+            {
+                entry.flags |= INTEGER;
+                entry.integer = *typed.integer;
+            }
+            if (typed.real)
+            {
+                entry.flags |= REAL;
+                entry.real = *typed.real;
+            }
+            if (typed.single)
+            {
+                entry.flags |= FLOAT;
+                entry.single = *typed.single;
+            }
+            if (typed.boolean)
+            {
+                entry.flags |= *typed.boolean ? BOOLEAN | TRUE_VALUE : BOOLEAN;
+            }
+            entries_.push_back(entry);
+        }
+
+        [[nodiscard]] std::string build(const ConfigCache::Format format, const SourceStamp& stamp,
+                                        const uint64_t sourceHash)
+        {
+            uint32_t bucketCount = 1;
+            while (bucketCount < entries_.size() * 2)
+                bucketCount <<= 1;
+            std::vector<uint32_t> buckets(bucketCount, kNone);
+            for (uint32_t i = 0; i < entries_.size(); ++i)
+            {
+                CacheEntry& entry = entries_[i];
+                const uint64_t hash = hashKey({strings_.data() + entry.section, entry.sectionSize},
+                                              {strings_.data() + entry.name, entry.nameSize}, ignoreCase_);
+                uint32_t& head = buckets[hash & (bucketCount - 1)];
+                entry.next = head;
+                head = i;
+            }
+
+            CacheHeader header{};
+            std::memcpy(header.magic, kMagic, sizeof(kMagic));
+            header.version = kVersion;
+            header.byteOrder = kByteOrder;
+            header.format = static_cast<uint32_t>(format);
+            header.entryCount = static_cast<uint32_t>(entries_.size());
+            header.bucketCount = bucketCount;
+            header.sourceSize = stamp.size;
+            header.sourceTime = stamp.time;
+            header.sourceHash = sourceHash;
+            header.entriesOffset = sizeof(CacheHeader);
+            header.bucketsOffset = header.entriesOffset + entries_.size() * sizeof(CacheEntry);
+            header.stringsOffset = (header.bucketsOffset + bucketCount * sizeof(uint32_t) + 7) / 8 * 8;
+            header.stringsSize = strings_.size();
+            header.totalSize = header.stringsOffset + strings_.size();
+
+            std::string blob(header.totalSize, '\0');
+            std::memcpy(&blob[header.entriesOffset], entries_.data(), entries_.size() * sizeof(CacheEntry));
+            std::memcpy(&blob[header.bucketsOffset], buckets.data(), buckets.size() * sizeof(uint32_t));
+            std::memcpy(&blob[header.stringsOffset], strings_.data(), strings_.size());
+            header.checksum = hashBytes(blob.data() + sizeof(CacheHeader), blob.size() - sizeof(CacheHeader));
+            std::memcpy(&blob[0], &header, sizeof(header));
+            return blob;
+        }
+
+    private:
+        bool ignoreCase_;
+        std::string strings_;
+        std::vector<CacheEntry> entries_;
+        std::unordered_map<std::string, uint32_t> sections_;
+
+        uint32_t append(const std::string_view text)
+        {
+            const auto offset = static_cast<uint32_t>(strings_.size());
+            strings_.append(text);
+            return offset;
+        }
+    };
+
+    bool parseIni(const std::string& content, CacheBuilder& builder)
+    {
+        const INIReader reader(content.data(), content.size());
+        // 与INIReader一致,有错误的行只打印警告,其余的值照常生成缓存
+        if (reader.ParseError() != 0)
+        {
+            DLL_LOG_WARN(MODULE_NAME) << "INI配置存在无法解析的行,错误行:" << reader.ParseError();
+        }
+        // Sections()中大小写不同的同名节只处理一次
+        std::unordered_set<std::string> visited;
+        for (const auto& section : reader.Sections())
+        {
+            std::string lowered = section;
+            for (char& c : lowered)
+                c = fold(c, true);
+            if (!visited.insert(lowered).second)
+                continue;
+            for (const auto& name : reader.Keys(section))
+            {
+                builder.add(section, name, reader.TryGet(section, name).value_or(""),
+                            {
+                                reader.TryGetInteger(section, name), reader.TryGetReal(section, name),
+                                reader.TryGetFloat(section, name), reader.TryGetBoolean(section, name)
+                            });
+            }
+        }
+        return true;
+    }
+
+    bool hasChildElement(const rapidxml::xml_node<>* node)
+    {
+        for (const auto* child = node->first_node(); child; child = child->next_sibling())
+        {
+            if (child->type() == rapidxml::node_element)
+                return true;
+        }
+        return false;
+    }
+
+    // XML的值按INIReader的规则转换
+    TypedValue parseTyped(const std::string_view value)
+    {
+        const std::string text(value);
+        return {
+            INIReader::ParseInteger(text), INIReader::ParseReal(text), INIReader::ParseFloat(text),
+            INIReader::ParseBoolean(text)
+        };
+    }
+
+    // 按元素路径展开XML,path为node的路径
+    void flattenXml(const rapidxml::xml_node<>* node, const std::string& path, CacheBuilder& builder)
+    {
+        for (const auto* attribute = node->first_attribute(); attribute; attribute = attribute->next_attribute())
+        {
+            const std::string_view value(attribute->value(), attribute->value_size());
+            builder.add(path, std::string("@") + attribute->name(), value, parseTyped(value));
+        }
+        std::unordered_map<std::string_view, int> counts;
+        for (const auto* child = node->first_node(); child; child = child->next_sibling())
+        {
+            if (child->type() == rapidxml::node_element)
+                ++counts[{child->name(), child->name_size()}];
+        }
+        std::unordered_map<std::string_view, int> seen;
+        for (const auto* child = node->first_node(); child; child = child->next_sibling())
+        {
+            if (child->type() != rapidxml::node_element)
+                continue;
+            const std::string_view name(child->name(), child->name_size());
+            std::string segment(name);
+            if (counts[name] > 1)
+                segment += "[" + std::to_string(++seen[name]) + "]";
+            const std::string childPath = path.empty() ? segment : path + "/" + segment;
+            if (!hasChildElement(child))
+            {
+                const std::string_view value(child->value(), child->value_size());
+                builder.add(path, segment, value, parseTyped(value));
+            }
+            flattenXml(child, childPath, builder);
+        }
+    }
+
+    bool parseXml(std::string content, CacheBuilder& builder)
+    {
+        try
+        {
+            rapidxml::xml_document<> document;
+            content.push_back('\0');
+            document.parse<rapidxml::parse_trim_whitespace>(&content[0]);
+            flattenXml(&document, "", builder);
+            return true;
+        }
+        catch (const rapidxml::parse_error& e)
+        {
+            DLL_LOG_ERROR(MODULE_NAME) << "XML配置解析失败:" << e.what();
+            return false;
+        }
+    }
+
+    // 解析源文件并生成缓存内容
+    bool buildCache(const std::string& source, const ConfigCache::Format format, std::string& blob)
+    {
+        const SourceStamp stamp = stampOf(source);
+        std::string content;
+        if (!stamp.exists || !readFile(source, content))
+        {
+            DLL_LOG_ERROR(MODULE_NAME) << "读取配置文件失败:" << source;
+            return false;
+        }
+        CacheBuilder builder(format == ConfigCache::Format::INI);
+        const uint64_t sourceHash = hashBytes(content.data(), content.size());
+        if (!(format == ConfigCache::Format::INI ? parseIni(content, builder) : parseXml(std::move(content), builder)))
+        {
+            return false;
+        }
+        blob = builder.build(format, stamp, sourceHash);
+        return true;
+    }
+
+    bool writeCache(const std::string& path, const std::string& blob)
+    {
+        std::random_device random;
+        const std::string temp = path + "." + std::to_string(random()) + ".tmp";
+        FILE* file = fopen(temp.c_str(), "wb");
+        if (!file)
+            return false;
+        const bool written = fwrite(blob.data(), 1, blob.size(), file) == blob.size();
+        const bool closed = fclose(file) == 0;
+        std::error_code error;
+        if (written && closed)
+            fs::rename(temp, path, error);
+        if (!written || !closed || error)
+        {
+            std::remove(temp.c_str());
+            return false;
+        }
+        return true;
+    }
+}
+
+class ConfigCache::Impl
+{
+public:
+    bool open(const std::string& source, const Format format, const std::string& cachePath)
+    {
+        close();
+        const std::string path = cachePath.empty() ? source + ".cache" : cachePath;
+        if (mapped_.map(path) && attach(mapped_.data(), mapped_.size(), format))
+        {
+            if (isFresh(source))
+            {
+                fromCache_ = true;
+                DLL_LOG_TRACE(MODULE_NAME) << "使用配置缓存:" << path << ",键数:" << static_cast<int>(size());
+                return true;
+            }
+            DLL_LOG_DEBUG(MODULE_NAME) << "配置缓存已过期,重新生成:" << path;
+        }
+        close();
+
+        if (!buildCache(source, format, memory_))
+        {
+            return false;
+        }
+        if (!writeCache(path, memory_))
+        {
+            DLL_LOG_WARN(MODULE_NAME) << "写入配置缓存失败,使用内存中的结果:" << path;
+        }
+        return attach(memory_.data(), memory_.size(), format);
+    }
+
+    void close()
+    {
+        mapped_.unmap();
+        memory_.clear();
+        header_ = nullptr;
+        fromCache_ = false;
+    }
+
+    [[nodiscard]] bool fromCache() const
+    {
+        return fromCache_;
+    }
+
+    [[nodiscard]] size_t size() const
+    {
+        return header_ ? header_->entryCount : 0;
+    }
+
+    [[nodiscard]] const CacheEntry* find(const std::string_view section, const std::string_view name) const
+    {
+        if (!header_)
+            return nullptr;
+        const uint64_t hash = hashKey(section, name, ignoreCase_);
+        for (uint32_t i = buckets_[hash & (header_->bucketCount - 1)]; i != kNone; i = entries_[i].next)
+        {
+            const CacheEntry& entry = entries_[i];
+            if (equals(text(entry.name, entry.nameSize), name, ignoreCase_) &&
+                equals(text(entry.section, entry.sectionSize), section, ignoreCase_))
+            {
+                return &entry;
+            }
+        }
+        return nullptr;
+    }
+
+    [[nodiscard]] std::string_view value(const CacheEntry& entry) const
+    {
+        return text(entry.value, entry.valueSize);
+    }
+
+    template <typename Visitor>
+    void forEach(Visitor visitor) const
+    {
+        for (uint32_t i = 0; i < size(); ++i)
+        {
+            const CacheEntry& entry = entries_[i];
+            visitor(text(entry.section, entry.sectionSize), text(entry.name, entry.nameSize), value(entry));
+        }
+    }
+
+private:
+    MappedFile mapped_;
+    std::string memory_; // 没有使用缓存文件时的编译结果
+    const CacheHeader* header_ = nullptr;
+    const CacheEntry* entries_ = nullptr;
+    const uint32_t* buckets_ = nullptr;
+    const char* strings_ = nullptr;
+    bool ignoreCase_ = true;
+    bool fromCache_ = false;
+
+    [[nodiscard]] std::string_view text(const uint32_t offset, const uint32_t size) const
+    {
+        return {strings_ + offset, size};
+    }
+
+    // 检查缓存的版本、格式、各部分的范围和校验和
+    bool attach(const char* data, const size_t size, const Format format)
+    {
+        if (size < sizeof(CacheHeader))
+            return false;
+        const auto* header = reinterpret_cast<const CacheHeader*>(data);
+        const uint64_t bucketsEnd = header->bucketsOffset + static_cast<uint64_t>(header->bucketCount) * sizeof(uint32_t);
+        if (std::memcmp(header->magic, kMagic, sizeof(kMagic)) != 0 || header->version != kVersion ||
+            header->byteOrder != kByteOrder || header->format != static_cast<uint32_t>(format) ||
+            header->totalSize != size || header->bucketCount == 0 ||
+            (header->bucketCount & (header->bucketCount - 1)) != 0 ||
+            header->entriesOffset != sizeof(CacheHeader) ||
+            header->bucketsOffset != header->entriesOffset + static_cast<uint64_t>(header->entryCount) * sizeof(CacheEntry) ||
+            header->stringsOffset < bucketsEnd || header->stringsOffset % 8 != 0 ||
+            header->stringsOffset + header->stringsSize != size ||
+            hashBytes(data + sizeof(CacheHeader), size - sizeof(CacheHeader)) != header->checksum)
+        {
+            DLL_LOG_DEBUG(MODULE_NAME) << "配置缓存格式不正确或已损坏";
+            return false;
+        }
+        const auto* entries = reinterpret_cast<const CacheEntry*>(data + header->entriesOffset);
+        const auto* buckets = reinterpret_cast<const uint32_t*>(data + header->bucketsOffset);
+        const auto inStrings = [&](const uint32_t offset, const uint32_t length)
+        {
+            return static_cast<uint64_t>(offset) + length <= header->stringsSize;
+        };
+        for (uint32_t i = 0; i < header->entryCount; ++i)
+        {
+            const CacheEntry& entry = entries[i];
+            if (!inStrings(entry.section, entry.sectionSize) || !inStrings(entry.name, entry.nameSize) ||
+                !inStrings(entry.value, entry.valueSize) || (entry.next != kNone && entry.next >= header->entryCount))
+                return false;
+        }
+        for (uint32_t i = 0; i < header->bucketCount; ++i)
+        {
+            if (buckets[i] != kNone && buckets[i] >= header->entryCount)
+                return false;
+        }
+        header_ = header;
+        entries_ = entries;
+        buckets_ = buckets;
+        strings_ = data + header->stringsOffset;
+        ignoreCase_ = format == Format::INI;
+        return true;
+    }
+
+    // 源文件的大小和修改时间与生成缓存时一致,或内容哈希一致时缓存有效;源文件不存在时直接使用缓存
+    [[nodiscard]] bool isFresh(const std::string& source) const
+    {
+        const SourceStamp stamp = stampOf(source);
+        if (!stamp.exists)
+        {
+            DLL_LOG_WARN(MODULE_NAME) << "配置文件不存在,直接使用缓存:" << source;
+            return true;
+        }
+        if (stamp.size == header_->sourceSize && stamp.time == header_->sourceTime)
+        {
+            return true;
+        }
+        std::string content;
+        return stamp.size == header_->sourceSize && readFile(source, content) &&
+            hashBytes(content.data(), content.size()) == header_->sourceHash;
+    }
+};
+
+ConfigCache::ConfigCache():
+    impl_(new Impl())
+{
+}
+
+ConfigCache::~ConfigCache()
+{
+    delete impl_;
+}
+
+bool ConfigCache::open(const std::string& source, const Format format, const std::string& cachePath)
+{
+    return impl_->open(source, format, cachePath);
+}
+
+bool ConfigCache::compile(const std::string& source, const Format format, const std::string& cachePath)
+{
+    std::string blob;
+    if (!buildCache(source, format, blob))
+    {
+        return false;
+    }
+    if (!writeCache(cachePath, blob))
+    {
+        DLL_LOG_ERROR(MODULE_NAME) << "写入配置缓存失败:" << cachePath;
+        return false;
+    }
+    return true;
+}
+
+bool ConfigCache::fromCache() const
+{
+    return impl_->fromCache();
+}
+
+size_t ConfigCache::size() const
+{
+    return impl_->size();
+}
+
+std::optional<std::string_view> ConfigCache::Find(const std::string& section, const std::string& name) const
+{
+    const CacheEntry* entry = impl_->find(section, name);
+    return entry ? std::optional<std::string_view>(impl_->value(*entry)) : std::nullopt;
+}
+
+std::string ConfigCache::Get(const std::string& section, const std::string& name,
+                             const std::string& default_value) const
+{
+    const CacheEntry* entry = impl_->find(section, name);
+    if (!entry && !default_value.empty())
+    {
+        DLL_LOG_CONFIG_WARN(MODULE_NAME, section, name, default_value)
+    }
+    return entry ? std::string(impl_->value(*entry)) : default_value;
+}
+
+long ConfigCache::GetInteger(const std::string& section, const std::string& name, const long default_value) const
+{
+    const CacheEntry* entry = impl_->find(section, name);
+    if (!entry || !(entry->flags & INTEGER))
+    {
+        DLL_LOG_CONFIG_WARN(MODULE_NAME, section, name, default_value)
+        return default_value;
+    }
+    return static_cast<long>(entry->integer);
+}
+
+double ConfigCache::GetReal(const std::string& section, const std::string& name, const double default_value) const
+{
+    const CacheEntry* entry = impl_->find(section, name);
+    if (!entry || !(entry->flags & REAL))
+    {
+        DLL_LOG_CONFIG_WARN(MODULE_NAME, section, name, default_value)
+        return default_value;
+    }
+    return entry->real;
+}
+
+float ConfigCache::GetFloat(const std::string& section, const std::string& name, const float default_value) const
+{
+    const CacheEntry* entry = impl_->find(section, name);
+    if (!entry || !(entry->flags & FLOAT))
+    {
+        DLL_LOG_CONFIG_WARN(MODULE_NAME, section, name, default_value)
+        return default_value;
+    }
+    return entry->single;
+}
+
+bool ConfigCache::GetBoolean(const std::string& section, const std::string& name, const bool default_value) const
+{
+    const CacheEntry* entry = impl_->find(section, name);
+    if (!entry || !(entry->flags & BOOLEAN))
+    {
+        DLL_LOG_CONFIG_WARN(MODULE_NAME, section, name, default_value)
+        return default_value;
+    }
+    return (entry->flags & TRUE_VALUE) != 0;
+}
+
+void ConfigCache::forEach(const std::function<void(std::string_view section, std::string_view name,
+                                                   std::string_view value)>& visitor) const
+{
+    impl_->forEach(visitor);
+}
@@ -0,0 +1,381 @@
+/**
+# @File     : event_store.cpp
+# @Author   : jade
+# @Date     : 2026/10/19 16:40
+# @Email    : jadehh@1ive.com
+# @Software : Samples
+# @Desc     : 按天分区的事件存储
+*/
+
+#include <map>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include "include/jade_tools.h"
+#ifdef LOW_GCC
+#include <experimental/filesystem>
+namespace fs = std::experimental::filesystem;
+#else
+#include <filesystem>
+namespace fs = std::filesystem;
+#endif
+#define MODULE_NAME "EventStore"
+
+using namespace jade;
+
+namespace
+{
+    constexpr SqliteInt64 kMillisPerDay = 24LL * 60 * 60 * 1000;
+
+    // 向下取整的除法, 1970年之前的时间戳也落在正确的天
+    SqliteInt64 floorDiv(const SqliteInt64 value, const SqliteInt64 divisor)
+    {
+        const SqliteInt64 quotient = value / divisor;
+        return value % divisor < 0 ? quotient - 1 : quotient;
+    }
+
+    // 1970-01-01起的天数转换为YYYYMMDD
+    std::string formatDay(SqliteInt64 days)
+    {
+        days += 719468;
+        const SqliteInt64 era = floorDiv(days, 146097);
+        const auto doe = static_cast<unsigned>(days - era * 146097);
+        const unsigned yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+        const unsigned doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+        const unsigned mp = (5 * doy + 2) / 153;
+        const unsigned day = doy - (153 * mp + 2) / 5 + 1;
+        const unsigned month = mp < 10 ? mp + 3 : mp - 9;
+        const auto year = static_cast<int>(static_cast<SqliteInt64>(yoe) + era * 400 + (month <= 2));
+        char buffer[16];
+        snprintf(buffer, sizeof(buffer), "%04d%02u%02u", year, month, day);
+        return buffer;
+    }
+
+    // YYYYMMDD转换为1970-01-01起的天数
+    SqliteInt64 parseDay(const std::string& text)
+    {
+        const int year = std::stoi(text.substr(0, 4));
+        const auto month = static_cast<unsigned>(std::stoi(text.substr(4, 2)));
+        const auto day = static_cast<unsigned>(std::stoi(text.substr(6, 2)));
+        const int y = year - (month <= 2);
+        const SqliteInt64 era = floorDiv(y, 400);
+        const auto yoe = static_cast<unsigned>(y - era * 400);
+        const unsigned doy = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+        const unsigned doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+        return era * 146097 + static_cast<SqliteInt64>(doe) - 719468;
+    }
+
+    void removeDatabaseFiles(const std::string& path)
+    {
+        std::remove(path.c_str());
+        std::remove((path + "-wal").c_str());
+        std::remove((path + "-shm").c_str());
+    }
+
+    // 一天的数据库文件; 被删除的分区在最后一个使用者释放后关闭并删除文件,
+    // 删除分区不需要等待正在进行的写入和查询
+    struct Partition
+    {
+        std::string path;
+        SqliteHelper db;
+        bool opened = false; // 由EventStore::Impl::mutex_保护
+        std::atomic<bool> expired{false};
+
+        ~Partition()
+        {
+            db.close();
+            if (expired)
+            {
+                removeDatabaseFiles(path);
+            }
+        }
+    };
+}
+
+class EventStore::Impl
+{
+public:
+    explicit Impl(const Options& options) : options_(options)
+    {
+        if (!FileTools::isExists(options_.directory) && !FileTools::createDirectories(options_.directory))
+        {
+            DLL_LOG_WARN(MODULE_NAME) << "创建目录失败: " << options_.directory;
+        }
+        // 登记已有的分区文件, 用到时再打开
+        const std::string prefix = options_.name + "_";
+        std::error_code error;
+        for (const auto& entry : fs::directory_iterator(options_.directory, error))
+        {
+            const std::string file = entry.path().filename().string();
+            if (file.size() != prefix.size() + 11 || file.compare(0, prefix.size(), prefix) != 0 ||
+                file.compare(file.size() - 3, 3, ".db") != 0)
+            {
+                continue;
+            }
+            const std::string digits = file.substr(prefix.size(), 8);
+            if (digits.find_first_not_of("0123456789") != std::string::npos)
+            {
+                continue;
+            }
+            auto partition = std::make_shared<Partition>();
+            partition->path = entry.path().string();
+            partitions_[parseDay(digits)] = std::move(partition);
+        }
+        DLL_LOG_TRACE(MODULE_NAME) << "打开事件存储:" << options_.directory << ",已有分区数:"
+            << static_cast<int>(partitions_.size());
+    }
+
+    bool insert(const std::vector<SqliteHelper::SQLiteValue>& row)
+    {
+        SqliteInt64 ts = 0;
+        if (!timestamp(row, ts))
+        {
+            return false;
+        }
+        const SqliteInt64 now = nowMs();
+        if (!acceptable(ts, now))
+        {
+            return false;
+        }
+        const auto partition = getPartition(dayOf(ts), dayOf(now));
+        return partition && partition->db.executeWithParams(insertSql(row.size()), row);
+    }
+
+    size_t insertBatch(const std::vector<std::vector<SqliteHelper::SQLiteValue>>& rows)
+    {
+        // 按天分组, 保持组内的原有顺序
+        std::map<SqliteInt64, std::vector<std::vector<SqliteHelper::SQLiteValue>>> groups;
+        const SqliteInt64 now = nowMs();
+        for (const auto& row : rows)
+        {
+            if (SqliteInt64 ts = 0; timestamp(row, ts) && acceptable(ts, now))
+            {
+                groups[dayOf(ts)].push_back(row);
+            }
+        }
+        size_t inserted = 0;
+        for (const auto& [day, group] : groups)
+        {
+            if (const auto partition = getPartition(day, dayOf(now)))
+            {
+                inserted += partition->db.executeBatch(insertSql(group.front().size()), group).succeeded;
+            }
+        }
+        return inserted;
+    }
+
+    size_t query(const SqliteInt64 begin, const SqliteInt64 end, const SqliteHelper::RowVisitor& visitor,
+                 const std::string& where, const std::vector<SqliteHelper::SQLiteValue>& params)
+    {
+        if (begin >= end)
+        {
+            return 0;
+        }
+        std::vector<std::shared_ptr<Partition>> selected;
+        {
+            std::lock_guard lock(mutex_);
+            const auto last = partitions_.upper_bound(dayOf(end - 1));
+            for (auto it = partitions_.lower_bound(dayOf(begin)); it != last; ++it)
+            {
+                if (open(*it->second))
+                {
+                    selected.push_back(it->second);
+                }
+            }
+        }
+        std::string sql = "SELECT * FROM " + options_.name + " WHERE ts >= ? AND ts < ?";
+        if (!where.empty())
+        {
+            sql += " AND (" + where + ")";
+        }
+        sql += " ORDER BY ts;";
+        std::vector<SqliteHelper::SQLiteValue> bound = {begin, end};
+        bound.insert(bound.end(), params.begin(), params.end());
+
+        size_t visited = 0;
+        bool stopped = false;
+        for (const auto& partition : selected)
+        {
+            visited += partition->db.queryEach(sql, bound, [&](const SqliteHelper::Row& row)
+            {
+                stopped = !visitor(row);
+                return !stopped;
+            });
+            if (stopped)
+            {
+                break;
+            }
+        }
+        return visited;
+    }
+
+    size_t dropExpired(const SqliteInt64 now)
+    {
+        std::lock_guard lock(mutex_);
+        return dropBefore(dayOf(now) - options_.retentionDays + 1);
+    }
+
+    std::vector<std::string> partitions()
+    {
+        std::lock_guard lock(mutex_);
+        std::vector<std::string> paths;
+        paths.reserve(partitions_.size());
+        for (const auto& [day, partition] : partitions_)
+        {
+            paths.push_back(partition->path);
+        }
+        return paths;
+    }
+
+private:
+    Options options_;
+    std::mutex mutex_;
+    std::map<SqliteInt64, std::shared_ptr<Partition>> partitions_; // 按天排序
+
+    [[nodiscard]] SqliteInt64 dayOf(const SqliteInt64 ts) const
+    {
+        return floorDiv(ts + static_cast<SqliteInt64>(options_.utcOffsetMinutes) * 60 * 1000, kMillisPerDay);
+    }
+
+    static SqliteInt64 nowMs()
+    {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+    }
+
+    // 超前当前时间太多的事件(设备时钟错误)直接拒绝, 不能让它创建未来的分区
+    [[nodiscard]] bool acceptable(const SqliteInt64 ts, const SqliteInt64 now) const
+    {
+        if (ts > now + static_cast<SqliteInt64>(options_.futureToleranceMinutes) * 60 * 1000)
+        {
+            DLL_LOG_WARN(MODULE_NAME) << "事件时间超前当前时间,请检查设备时钟:" << formatDay(dayOf(ts));
+            return false;
+        }
+        return true;
+    }
+
+    static bool timestamp(const std::vector<SqliteHelper::SQLiteValue>& row, SqliteInt64& ts)
+    {
+        const auto* value = row.empty() ? nullptr : std::get_if<SqliteInt64>(&row.front());
+        if (!value)
+        {
+            DLL_LOG_WARN(MODULE_NAME) << "事件的第一列必须是毫秒时间戳";
+            return false;
+        }
+        ts = *value;
+        return true;
+    }
+
+    std::string insertSql(const size_t columnCount) const
+    {
+        std::string sql = "INSERT INTO " + options_.name + " VALUES (";
+        for (size_t i = 0; i < columnCount; ++i)
+        {
+            sql += i == 0 ? "?" : ", ?";
+        }
+        return sql + ");";
+    }
+
+    // 获取某一天的分区, 不存在则创建; 保留期按当前时间所在的today计算, 不受事件时间影响,
+    // 新建分区时(如新的一天开始)顺带删除过期分区
+    std::shared_ptr<Partition> getPartition(const SqliteInt64 day, const SqliteInt64 today)
+    {
+        std::lock_guard lock(mutex_);
+        auto it = partitions_.find(day);
+        if (it == partitions_.end())
+        {
+            if (options_.retentionDays > 0 && day <= today - options_.retentionDays)
+            {
+                DLL_LOG_WARN(MODULE_NAME) << "事件所在的分区已过期:" << formatDay(day);
+                return nullptr;
+            }
+            auto partition = std::make_shared<Partition>();
+            partition->path = (fs::path(options_.directory) / (options_.name + "_" + formatDay(day) + ".db")).string();
+            it = partitions_.emplace(day, std::move(partition)).first;
+            dropBefore(today - options_.retentionDays + 1);
+        }
+        auto partition = it->second;
+        return open(*partition) ? partition : nullptr;
+    }
+
+    // 调用方需持有mutex_
+    bool open(Partition& partition) const
+    {
+        if (partition.opened)
+        {
+            return true;
+        }
+        try
+        {
+            partition.db.init(partition.path.c_str(), options_.profile, options_.readerCount);
+            if (!partition.db.execute("CREATE TABLE IF NOT EXISTS " + options_.name + " (ts INTEGER NOT NULL" +
+                (options_.columns.empty() ? "" : ", " + options_.columns) + ");CREATE INDEX IF NOT EXISTS " +
+                options_.name + "_ts ON " + options_.name + " (ts);"))
+            {
+                partition.db.close();
+                return false;
+            }
+            partition.opened = true;
+            DLL_LOG_TRACE(MODULE_NAME) << "打开分区:" << partition.path;
+        }
+        catch (const std::exception& e)
+        {
+            DLL_LOG_ERROR(MODULE_NAME) << "打开分区失败:" << partition.path << "," << e.what();
+        }
+        return partition.opened;
+    }
+
+    // 删除firstDay之前的分区, 调用方需持有mutex_
+    size_t dropBefore(const SqliteInt64 firstDay)
+    {
+        if (options_.retentionDays <= 0)
+        {
+            return 0;
+        }
+        size_t dropped = 0;
+        for (auto it = partitions_.begin(); it != partitions_.end() && it->first < firstDay;)
+        {
+            DLL_LOG_TRACE(MODULE_NAME) << "删除过期分区:" << it->second->path;
+            it->second->expired = true;
+            it = partitions_.erase(it);
+            ++dropped;
+        }
+        return dropped;
+    }
+};
+
+EventStore::EventStore(const Options& options):impl_(new Impl(options))
+{
+}
+
+EventStore::~EventStore()
+{
+    delete impl_;
+}
+
+bool EventStore::insert(const std::vector<SqliteHelper::SQLiteValue>& row) const
+{
+    return impl_->insert(row);
+}
+
+size_t EventStore::insertBatch(const std::vector<std::vector<SqliteHelper::SQLiteValue>>& rows) const
+{
+    return impl_->insertBatch(rows);
+}
+
+size_t EventStore::query(const SqliteInt64 begin, const SqliteInt64 end, const SqliteHelper::RowVisitor& visitor,
+                         const std::string& where, const std::vector<SqliteHelper::SQLiteValue>& params) const
+{
+    return impl_->query(begin, end, visitor, where, params);
+}
+
+size_t EventStore::dropExpired(const SqliteInt64 now) const
+{
+    return impl_->dropExpired(now);
+}
+
+std::vector<std::string> EventStore::partitions() const
+{
+    return impl_->partitions();
+}
@@ -9,13 +9,205 @@
 #include "include/jade_tools.h"
 #include <algorithm>
 #include <cctype>
-#include "include/ini_reader.h"
+#include <cstring>
+#include <deque>
+#include <map>
+#include <string_view>
+#include <unordered_map>
 #include <iostream>
+#ifdef LOW_GCC
+#include <experimental/filesystem>
+namespace fs = std::experimental::filesystem;
+#else
+#include <filesystem>
+namespace fs = std::filesystem;
+#endif
 #define MODULE_NAME "INIReader"
-#define LOG_INIREADER_WARN(section,name,default_value)  DLL_LOG_WARN(MODULE_NAME) << "节点名:\"" << (section) << "\"" << ",字段名: \"" << (name) << "\",读取异常,请检查配置文件,使用默认值:" << (default_value);
+#define LOG_INIREADER_WARN(section,name,default_value)  DLL_LOG_CONFIG_WARN(MODULE_NAME,section,name,default_value)
 
 using namespace jade;
 
+namespace
+{
+    // 配置文件内容,解析出的节名、键名和值都指向这块内存。文件一次读入而不是mmap映射:
+    // 运行中编辑配置文件会改变映射的内容,文件被截短后访问映射还会触发SIGBUS
+    class ConfigBuffer
+    {
+    public:
+        bool load(const std::string& filename)
+        {
+            std::error_code error;
+            if (!fs::is_regular_file(filename, error))
+                return false;
+            FILE* file = fopen(filename.c_str(), "rb");
+            if (!file)
+                return false;
+            // 已知大小时直接读入data_,之后再读取期间追加的内容
+            if (fseek(file, 0, SEEK_END) == 0)
+            {
+                const long size = ftell(file);
+                rewind(file);
+                if (size > 0)
+                {
+                    data_.resize(static_cast<size_t>(size));
+                    data_.resize(fread(data_.data(), 1, data_.size(), file));
+                }
+            }
+            const bool ok = read(file);
+            fclose(file);
+            return ok;
+        }
+
+        bool read(FILE* file)
+        {
+            char chunk[64 * 1024];
+            size_t n;
+            while ((n = fread(chunk, 1, sizeof(chunk), file)) > 0)
+                data_.append(chunk, n);
+            return ferror(file) == 0;
+        }
+
+        void assign(const char* data, const size_t size)
+        {
+            data_.assign(data, size);
+        }
+
+        [[nodiscard]] std::string_view view() const
+        {
+            return data_;
+        }
+
+    private:
+        std::string data_;
+    };
+
+    inline bool isSpace(const char c)
+    {
+        return std::isspace(static_cast<unsigned char>(c)) != 0;
+    }
+
+    // 只转换ASCII字母,与"C"区域设置下的std::tolower一致,非ASCII(如中文)字节保持不变
+    inline char lower(const char c)
+    {
+        return c >= 'A' && c <= 'Z' ? static_cast<char>(c - 'A' + 'a') : c;
+    }
+
+    std::string_view lskip(std::string_view text)
+    {
+        while (!text.empty() && isSpace(text.front()))
+            text.remove_prefix(1);
+        return text;
+    }
+
+    std::string_view rstrip(std::string_view text)
+    {
+        while (!text.empty() && isSpace(text.back()))
+            text.remove_suffix(1);
+        return text;
+    }
+
+    // 返回第一个属于chars的字符或行内注释的位置,都没有时返回text.size();
+    // 行内注释(; 或 #)前面必须是空白字符
+    size_t findCharsOrComment(const std::string_view text, const char* chars)
+    {
+        bool wasSpace = false;
+        for (size_t i = 0; i < text.size(); ++i)
+        {
+            const char c = text[i];
+            if (c == '\0' || (chars && std::strchr(chars, c)) || (wasSpace && (c == ';' || c == '#')))
+                return i;
+            wasSpace = isSpace(c);
+        }
+        return text.size();
+    }
+
+    bool equalsIgnoreCase(const std::string_view a, const std::string_view b)
+    {
+        if (a.size() != b.size())
+            return false;
+        for (size_t i = 0; i < a.size(); ++i)
+        {
+            if (lower(a[i]) != lower(b[i]))
+                return false;
+        }
+        return true;
+    }
+
+    bool startsWithIgnoreCase(const std::string_view text, const std::string_view prefix)
+    {
+        return text.size() >= prefix.size() && equalsIgnoreCase(text.substr(0, prefix.size()), prefix);
+    }
+
+    // 节名和键名都指向配置内容,比较和哈希时忽略大小写,查找时不需要构造小写的键
+    struct EntryKey
+    {
+        std::string_view section;
+        std::string_view name;
+    };
+
+    struct EntryKeyHash
+    {
+        size_t operator()(const EntryKey& key) const
+        {
+            // FNV-1a
+            uint64_t hash = 14695981039346656037ULL;
+            const auto mix = [&hash](const std::string_view text)
+            {
+                for (const char c : text)
+                {
+                    hash ^= static_cast<unsigned char>(lower(c));
+                    hash *= 1099511628211ULL;
+                }
+            };
+            mix(key.section);
+            hash ^= '=';
+            hash *= 1099511628211ULL;
+            mix(key.name);
+            return static_cast<size_t>(hash);
+        }
+    };
+
+    struct EntryKeyEqual
+    {
+        bool operator()(const EntryKey& a, const EntryKey& b) const
+        {
+            return equalsIgnoreCase(a.section, b.section) && equalsIgnoreCase(a.name, b.name);
+        }
+    };
+
+    // 忽略大小写的排序,与两边都转为小写后按字节比较的结果一致;以某个前缀开头的键在排序后是连续的
+    struct LessIgnoreCase
+    {
+        using is_transparent = void;
+
+        bool operator()(const std::string_view a, const std::string_view b) const
+        {
+            return std::lexicographical_compare(a.begin(), a.end(), b.begin(), b.end(), [](const char x, const char y)
+            {
+                return static_cast<unsigned char>(lower(x)) < static_cast<unsigned char>(lower(y));
+            });
+        }
+    };
+
+    // 节内的键名(保持文件中的写法)和_slots下标,按LessIgnoreCase排序
+    using SectionKeys = std::vector<std::pair<std::string_view, uint32_t>>;
+
+    // 一个键的值,以及加载时按各类型解析好的结果
+    struct Slot
+    {
+        std::string_view section;
+        std::string_view name;
+        std::string_view text;
+        long integer = 0;
+        double real = 0;
+        float single = 0;
+        bool boolean = false;
+        bool isInteger = false;
+        bool isReal = false;
+        bool isFloat = false;
+        bool isBoolean = false;
+    };
+}
 
 class INIReader::Impl
 {
@@ -27,68 +219,230 @@ public:
 
     explicit Impl(const std::string& filename)
     {
-        _error = ini_parse(filename.c_str(), ValueHandler, this);
+        _error = _buffer.load(filename) ? Load(_buffer.view()) : -1;
     };
 
     explicit Impl(FILE* file)
     {
-        _error = ini_parse_file(file, ValueHandler, this);
+        _buffer.read(file);
+        _error = Load(_buffer.view());
     }
 
-    std::map<std::string, std::string> _values;
+    Impl(const char* data, const size_t size)
+    {
+        _buffer.assign(data, size);
+        _error = Load(_buffer.view());
+    }
+
+    ConfigBuffer _buffer;
+    // 键到_slots下标的映射;值指向配置内容,同名键拼接后的值保存在_joined中
+    std::unordered_map<EntryKey, uint32_t, EntryKeyHash, EntryKeyEqual> _values;
+    std::vector<Slot> _slots;
+    std::deque<std::string> _joined;
+    // 按节名排序的各节的键,用于前缀查询和遍历
+    std::map<std::string_view, SectionKeys, LessIgnoreCase> _index;
     std::set<std::string> _sections;
+    std::string_view _lastSection; // 上一个键所在的节,同一节内的键不再重复插入_sections
     int _error;
-    static std::string MakeKey(const std::string& section, const std::string& name){
-        std::string key = section + "=" + name;
-        // Convert to lower case to make section/name lookups case-insensitive
-        std::transform(key.begin(), key.end(), key.begin(), ::tolower);
-        return key;
+
+    [[nodiscard]] const Slot* Find(const std::string& section, const std::string& name) const
+    {
+        const auto it = _values.find(EntryKey{section, name});
+        return it == _values.end() ? nullptr : &_slots[it->second];
     }
-    std::vector<std::string> GetKeys(const std::string& section) const
+
+    [[nodiscard]] const Slot* At(const uint32_t slot) const
+    {
+        return slot < _slots.size() ? &_slots[slot] : nullptr;
+    }
+
+    [[nodiscard]] const SectionKeys* Keys(const std::string_view section) const
     {
-        std::vector<std::string> keys;
-        std::string prefix = section + "=";
-        std::transform(prefix.begin(), prefix.end(), prefix.begin(), ::tolower);
-        for (const auto& [fst, snd] : _values)
+        const auto it = _index.find(section);
+        return it == _index.end() ? nullptr : &it->second;
+    }
+
+    // 按键名顺序访问节内以prefix开头的键(不区分大小写),在有序的键名中二分查找起点
+    template <typename Visitor>
+    void ForEachWithPrefix(const std::string& section, const std::string_view prefix, Visitor visitor) const
+    {
+        const SectionKeys* keys = Keys(section);
+        if (!keys)
         {
-            if (fst.compare(0, prefix.size(), prefix) == 0)
-            {
-                keys.push_back(fst.substr(prefix.size()));
-            }
+            return;
+        }
+        auto it = std::lower_bound(keys->begin(), keys->end(), prefix, [](const auto& key, const std::string_view value)
+        {
+            return LessIgnoreCase()(key.first, value);
+        });
+        for (; it != keys->end() && startsWithIgnoreCase(it->first, prefix); ++it)
+        {
+            visitor(it->first, _slots[it->second]);
         }
-        return keys;
     }
 
-    std::vector<std::pair<std::string, std::string>> GetKeysWithPrefix(const std::string& section, const std::string& prefix)
+    // 两个节的键名和值是否都相同
+    [[nodiscard]] bool SameKeys(const SectionKeys& keys, const Impl& other, const SectionKeys& otherKeys) const
     {
-        std::vector<std::pair<std::string, std::string>> result;
+        return std::equal(keys.begin(), keys.end(), otherKeys.begin(), otherKeys.end(),
+                          [&](const auto& a, const auto& b)
+                          {
+                              return equalsIgnoreCase(a.first, b.first) &&
+                                  _slots[a.second].text == other._slots[b.second].text;
+                          });
+    }
 
-        // 1. 获取该section下所有键
-        const std::vector<std::string> keys = GetKeys(section);
-        std::string prefix_lower = prefix;
-        std::transform(prefix_lower.begin(), prefix_lower.end(), prefix_lower.begin(), ::tolower);
+    // 同名键(包括多行值)追加到已有的值之后
+    void AddValue(const std::string_view section, const std::string_view name, const std::string_view value)
+    {
+        auto [it, inserted] = _values.try_emplace(EntryKey{section, name}, static_cast<uint32_t>(_slots.size()));
+        if (inserted)
+        {
+            _slots.push_back(Slot{section, name, value});
+        }
+        else if (std::string_view& text = _slots[it->second].text; text.empty())
+        {
+            text = value;
+        }
+        else
+        {
+            std::string joined;
+            joined.reserve(text.size() + value.size() + 1);
+            joined.append(text).append(1, '\n').append(value);
+            text = _joined.emplace_back(std::move(joined));
+        }
+        if (_sections.empty() || _lastSection != section)
+        {
+            _lastSection = section;
+            _sections.emplace(section);
+        }
+    }
 
-        // 2. 过滤出以prefix开头的键
-        for (const auto& key : keys) {
-            if (key.compare(0, prefix_lower.length(), prefix_lower) == 0) {  // 检查前缀匹配
-                std::string value =  _values[MakeKey(section, key)];
-                result.emplace_back(key, value);
+    int Load(const std::string_view text)
+    {
+        const int error = Parse(text);
+        ParseValues();
+        BuildIndex();
+        return error;
+    }
+
+    // 按文件中的顺序建立索引,同一节的键通常是连续的,只在节变化时查找_index
+    void BuildIndex()
+    {
+        SectionKeys* keys = nullptr;
+        std::string_view section;
+        for (uint32_t i = 0; i < _slots.size(); ++i)
+        {
+            const Slot& slot = _slots[i];
+            if (!keys || slot.section.data() != section.data() || slot.section.size() != section.size())
+            {
+                section = slot.section;
+                keys = &_index[section];
             }
+            keys->emplace_back(slot.name, i);
+        }
+        for (auto& [name, sectionKeys] : _index)
+        {
+            std::sort(sectionKeys.begin(), sectionKeys.end(), [](const auto& a, const auto& b)
+            {
+                return LessIgnoreCase()(a.first, b.first);
+            });
         }
-        // 3. 按键名字典序排序（可选）
-        std::sort(result.begin(), result.end(),[](const auto& a, const auto& b) { return a.first < b.first; });
-        return result;
     }
 
-    static int ValueHandler(void* user, const char* section, const char* name, const char* value){
-        const auto impl = static_cast<Impl*>(user);
-        const std::string key = MakeKey(section, name);
-        auto values = impl->_values;
-        if (!impl->_values[key].empty())
-            impl->_values[key] += "\n";
-        impl->_values[key] += value;
-        impl->_sections.insert(section);
-        return 1;
+    // 按整数、浮点数和布尔值解析每个值,与GetInteger等接口的转换规则一致
+    void ParseValues()
+    {
+        std::string value;
+        for (Slot& slot : _slots)
+        {
+            value.assign(slot.text);
+            if (const std::optional<long> integer = ParseInteger(value))
+            {
+                slot.integer = *integer;
+                slot.isInteger = true;
+            }
+            if (const std::optional<double> real = ParseReal(value))
+            {
+                slot.real = *real;
+                slot.isReal = true;
+            }
+            if (const std::optional<float> single = ParseFloat(value))
+            {
+                slot.single = *single;
+                slot.isFloat = true;
+            }
+            if (const std::optional<bool> boolean = ParseBoolean(value))
+            {
+                slot.boolean = *boolean;
+                slot.isBoolean = true;
+            }
+        }
+    }
+
+    // 与inih的规则一致: [section]、name=value或name:value、行首;或#为注释、空白后的;或#为行内注释、
+    // 以空白开头的行是上一个键的续行、值两端的双引号会去掉;返回第一个错误的行号,没有错误时返回0。
+    // 换行用memchr查找(标准库中为向量化实现),不限制行的长度
+    int Parse(const std::string_view text)
+    {
+        const char* p = text.data();
+        const char* const end = p + text.size();
+        std::string_view section;
+        std::string_view prevName;
+        int lineno = 0;
+        int error = 0;
+        while (p < end)
+        {
+            ++lineno;
+            const auto* newline = static_cast<const char*>(std::memchr(p, '\n', end - p));
+            std::string_view line(p, (newline ? newline : end) - p);
+            p = newline ? newline + 1 : end;
+            if (lineno == 1 && line.size() >= 3 && line.compare(0, 3, "\xEF\xBB\xBF") == 0)
+            {
+                line.remove_prefix(3);
+            }
+            const bool indented = !line.empty() && isSpace(line.front());
+            line = lskip(rstrip(line));
+            if (line.empty() || line.front() == ';' || line.front() == '#')
+            {
+                continue;
+            }
+            if (indented && !prevName.empty())
+            {
+                AddValue(section, prevName, rstrip(line.substr(0, findCharsOrComment(line, nullptr))));
+            }
+            else if (line.front() == '[')
+            {
+                const std::string_view rest = line.substr(1);
+                if (const size_t close = findCharsOrComment(rest, "]"); close < rest.size() && rest[close] == ']')
+                {
+                    section = rest.substr(0, close);
+                    prevName = {};
+                }
+                else if (!error)
+                {
+                    error = lineno;
+                }
+            }
+            else if (const size_t pos = findCharsOrComment(line, "=:"); pos < line.size() && (line[pos] == '=' || line[pos] == ':'))
+            {
+                const std::string_view name = rstrip(line.substr(0, pos));
+                std::string_view value = lskip(line.substr(pos + 1));
+                value = rstrip(value.substr(0, findCharsOrComment(value, nullptr)));
+                // 去除值两端的引号,只有一个引号时为空值
+                if (!value.empty() && value.front() == '"' && value.back() == '"')
+                {
+                    value = value.size() >= 2 ? value.substr(1, value.size() - 2) : std::string_view();
+                }
+                prevName = name;
+                AddValue(section, name, value);
+            }
+            else if (!error)
+            {
+                error = lineno;
+            }
+        }
+        return error;
     }
 };
 
@@ -97,6 +451,11 @@ INIReader::INIReader():
 {
 }
 
+INIReader::INIReader(const char* data, const size_t size):
+    impl_(new Impl(data, size))
+{
+}
+
 INIReader::INIReader(const std::string& filename):
     impl_(new Impl(filename))
 {
@@ -107,6 +466,11 @@ INIReader::INIReader(FILE* file):
 {
 }
 
+INIReader::~INIReader()
+{
+    delete impl_;
+}
+
 int INIReader::ParseError() const
 {
     return impl_->_error;
@@ -117,55 +481,194 @@ const std::set<std::string>& INIReader::Sections() const
     return impl_->_sections;
 }
 
+std::set<std::string> INIReader::ChangedSections(const INIReader& other) const
+{
+    std::set<std::string> changed;
+    for (const auto& [section, keys] : impl_->_index)
+    {
+        const SectionKeys* otherKeys = other.impl_->Keys(section);
+        if (!otherKeys || !impl_->SameKeys(keys, *other.impl_, *otherKeys))
+        {
+            changed.emplace(section);
+        }
+    }
+    for (const auto& [section, keys] : other.impl_->_index)
+    {
+        if (!impl_->Keys(section))
+        {
+            changed.emplace(section);
+        }
+    }
+    return changed;
+}
+
+std::optional<std::string> INIReader::TryGet(const std::string& section, const std::string& name) const
+{
+    const Slot* slot = impl_->Find(section, name);
+    return slot ? std::optional<std::string>(slot->text) : std::nullopt;
+}
+
+std::optional<long> INIReader::TryGetInteger(const std::string& section, const std::string& name) const
+{
+    const Slot* slot = impl_->Find(section, name);
+    return slot && slot->isInteger ? std::optional<long>(slot->integer) : std::nullopt;
+}
+
+std::optional<double> INIReader::TryGetReal(const std::string& section, const std::string& name) const
+{
+    const Slot* slot = impl_->Find(section, name);
+    return slot && slot->isReal ? std::optional<double>(slot->real) : std::nullopt;
+}
+
+std::optional<float> INIReader::TryGetFloat(const std::string& section, const std::string& name) const
+{
+    const Slot* slot = impl_->Find(section, name);
+    return slot && slot->isFloat ? std::optional<float>(slot->single) : std::nullopt;
+}
+
+std::optional<bool> INIReader::TryGetBoolean(const std::string& section, const std::string& name) const
+{
+    const Slot* slot = impl_->Find(section, name);
+    return slot && slot->isBoolean ? std::optional<bool>(slot->boolean) : std::nullopt;
+}
+
+std::optional<long> INIReader::ParseInteger(const std::string& text)
+{
+    const char* begin = text.c_str();
+    char* end;
+    // This parses "1234" (decimal) and also "0x4D2" (hex)
+    const long value = strtol(begin, &end, 0);
+    return end > begin ? std::optional<long>(value) : std::nullopt;
+}
+
+std::optional<double> INIReader::ParseReal(const std::string& text)
+{
+    const char* begin = text.c_str();
+    char* end;
+    const double value = strtod(begin, &end);
+    return end > begin ? std::optional<double>(value) : std::nullopt;
+}
+
+std::optional<float> INIReader::ParseFloat(const std::string& text)
+{
+    const char* begin = text.c_str();
+    char* end;
+    const float value = strtof(begin, &end);
+    return end > begin ? std::optional<float>(value) : std::nullopt;
+}
+
+std::optional<bool> INIReader::ParseBoolean(const std::string& text)
+{
+    for (const char* word : {"true", "yes", "on", "1"})
+    {
+        if (equalsIgnoreCase(text, word))
+            return true;
+    }
+    for (const char* word : {"false", "no", "off", "0"})
+    {
+        if (equalsIgnoreCase(text, word))
+            return false;
+    }
+    return std::nullopt;
+}
+
+std::vector<std::string> INIReader::Keys(const std::string& section) const
+{
+    std::vector<std::string> names;
+    if (const SectionKeys* keys = impl_->Keys(section))
+    {
+        names.reserve(keys->size());
+        for (const auto& [name, slot] : *keys)
+        {
+            names.emplace_back(name);
+        }
+    }
+    return names;
+}
+
+INIReader::Key INIReader::key(const std::string& section, const std::string& name) const
+{
+    const auto it = impl_->_values.find(EntryKey{section, name});
+    if (it == impl_->_values.end())
+    {
+        DLL_LOG_WARN(MODULE_NAME) << "节点名:\"" << section << "\",字段名: \"" << name << "\",不存在,读取时使用默认值";
+        return {};
+    }
+    return Key(it->second);
+}
+
 std::string INIReader::Get(const std::string& section,
                            const std::string& name,
                            const std::string& default_value) const
 {
-    const std::string key = Impl::MakeKey(section, name);
-    if (! impl_->_values.count(key) && !default_value.empty())
+    const Slot* slot = impl_->Find(section, name);
+    if (!slot && !default_value.empty())
     {
         LOG_INIREADER_WARN(section, name, default_value)
     }
-    return impl_->_values.count(key) ? impl_->_values[key] : default_value;
+    return slot ? std::string(slot->text) : default_value;
 }
 
-
-
+std::string INIReader::Get(const Key& key, const std::string& default_value) const
+{
+    const Slot* slot = impl_->At(key.slot_);
+    return slot ? std::string(slot->text) : default_value;
+}
 
 long INIReader::GetInteger(const std::string& section,
                            const std::string& name,
                            const long default_value) const
 {
-    const std::string valStr = Get(section, name, "");
-    const char* value = valStr.c_str();
-    char* end;
-    // This parses "1234" (decimal) and also "0x4D2" (hex)
-    const long n = strtol(value, &end, 0);
-    if (end <= value)
+    const Slot* slot = impl_->Find(section, name);
+    if (!slot || !slot->isInteger)
     {
         LOG_INIREADER_WARN(section, name, default_value)
+        return default_value;
     }
-    return end > value ? n : default_value;
+    return slot->integer;
+}
+
+long INIReader::GetInteger(const Key& key, const long default_value) const
+{
+    const Slot* slot = impl_->At(key.slot_);
+    return slot && slot->isInteger ? slot->integer : default_value;
 }
+
 std::vector<long> INIReader::GetIntegerWithPrefix(const std::string& section, const std::string& prefix) const
 {
-    auto pairs = impl_->GetKeysWithPrefix(section, prefix);
     std::vector<long> result;
-    for (const auto& [key, value] : pairs)
+    impl_->ForEachWithPrefix(section, prefix, [&](const std::string_view name, const Slot& slot)
     {
-        const char* valStr = value.c_str();
-        char* end;
-        // This parses "1234" (decimal) and also "0x4D2" (hex)
-        const long n = strtol(valStr, &end, 0);
-        if (end > valStr)
+        result.push_back(slot.isInteger ? slot.integer : 0);
+        if (!slot.isInteger)
         {
-            result.push_back(n);
-        }else
+            LOG_INIREADER_WARN(section, std::string(name), 0)
+        }
+    });
+    return result;
+}
+
+std::vector<double> INIReader::GetRealWithPrefix(const std::string& section, const std::string& prefix) const
+{
+    std::vector<double> result;
+    impl_->ForEachWithPrefix(section, prefix, [&](const std::string_view name, const Slot& slot)
+    {
+        result.push_back(slot.isReal ? slot.real : 0);
+        if (!slot.isReal)
         {
-            result.push_back(0);
-            LOG_INIREADER_WARN(section, key, 0)
+            LOG_INIREADER_WARN(section, std::string(name), 0)
         }
-    }
+    });
+    return result;
+}
+
+std::vector<std::string> INIReader::GetStringWithPrefix(const std::string& section, const std::string& prefix) const
+{
+    std::vector<std::string> result;
+    impl_->ForEachWithPrefix(section, prefix, [&](std::string_view, const Slot& slot)
+    {
+        result.emplace_back(slot.text);
+    });
     return result;
 }
 
@@ -173,44 +676,55 @@ double INIReader::GetReal(const std::string& section,
                           const std::string& name,
                           const double default_value) const
 {
-    const std::string valStr = Get(section, name, "");
-    const char* value = valStr.c_str();
-    char* end;
-    const double n = strtod(value, &end);
-    if (end <= value)
+    const Slot* slot = impl_->Find(section, name);
+    if (!slot || !slot->isReal)
     {
         LOG_INIREADER_WARN(section, name, default_value)
+        return default_value;
     }
-    return end > value ? n : default_value;
+    return slot->real;
+}
+
+double INIReader::GetReal(const Key& key, const double default_value) const
+{
+    const Slot* slot = impl_->At(key.slot_);
+    return slot && slot->isReal ? slot->real : default_value;
 }
 
 float INIReader::GetFloat(const std::string& section,
                           const std::string& name,
                           const float default_value) const
 {
-    const std::string valStr = Get(section, name, "");
-    const char* value = valStr.c_str();
-    char* end;
-    const float n = strtof(value, &end);
-    if (end <= value)
+    const Slot* slot = impl_->Find(section, name);
+    if (!slot || !slot->isFloat)
     {
         LOG_INIREADER_WARN(section, name, default_value)
+        return default_value;
     }
-    return end > value ? n : default_value;
+    return slot->single;
+}
+
+float INIReader::GetFloat(const Key& key, const float default_value) const
+{
+    const Slot* slot = impl_->At(key.slot_);
+    return slot && slot->isFloat ? slot->single : default_value;
 }
 
 bool INIReader::GetBoolean(const std::string& section,
                            const std::string& name,
                            const bool default_value) const
 {
-    std::string valStr = Get(section, name, "");
-    // Convert to lower case to make string comparisons case-insensitive
-    std::transform(valStr.begin(), valStr.end(), valStr.begin(), ::tolower);
-    if (valStr == "true" || valStr == "yes" || valStr == "on" || valStr == "1")
-        return true;
-    if (valStr == "false" || valStr == "no" || valStr == "off" ||
-        valStr == "0")
-        return false;
-    LOG_INIREADER_WARN(section, name, default_value)
-    return default_value;
+    const Slot* slot = impl_->Find(section, name);
+    if (!slot || !slot->isBoolean)
+    {
+        LOG_INIREADER_WARN(section, name, default_value)
+        return default_value;
+    }
+    return slot->boolean;
+}
+
+bool INIReader::GetBoolean(const Key& key, const bool default_value) const
+{
+    const Slot* slot = impl_->At(key.slot_);
+    return slot && slot->isBoolean ? slot->boolean : default_value;
 }
@@ -0,0 +1,316 @@
+/**
+# @File     : ini_watcher.cpp
+# @Author   : jade
+# @Date     : 2026/10/19 20:30
+# @Email    : jadehh@1ive.com
+# @Software : Samples
+# @Desc     : ini配置热加载
+*/
+#include "include/jade_tools.h"
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#ifdef LOW_GCC
+#include <experimental/filesystem>
+namespace fs = std::experimental::filesystem;
+#else
+#include <filesystem>
+namespace fs = std::filesystem;
+#endif
+#ifdef __linux__
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+#define MODULE_NAME "INIWatcher"
+
+using namespace jade;
+
+class INIWatcher::Impl
+{
+public:
+    Impl(std::string filename, const int pollIntervalMs):
+        filename_(std::move(filename)), pollIntervalMs_(std::max(10, pollIntervalMs))
+    {
+        auto reader = std::make_shared<const INIReader>(filename_);
+        if (reader->ParseError() != 0)
+        {
+            DLL_LOG_WARN(MODULE_NAME) << "配置文件解析失败:" << filename_ << ",错误:" << reader->ParseError();
+        }
+        std::atomic_store(&snapshot_, Snapshot(std::move(reader)));
+        start();
+    }
+
+    ~Impl()
+    {
+        stop();
+    }
+
+    [[nodiscard]] Snapshot snapshot() const
+    {
+        return std::atomic_load(&snapshot_);
+    }
+
+    void onSectionChanged(const std::string& section, const SectionCallback& callback)
+    {
+        std::lock_guard lock(callbackMutex_);
+        callbacks_.emplace_back(section, callback);
+    }
+
+    // 回调在释放reloadMutex_后执行,回调中可以调用reload和stop
+    bool reload()
+    {
+        Snapshot previous;
+        Snapshot current;
+        std::set<std::string> changed;
+        {
+            std::lock_guard lock(reloadMutex_);
+            auto reader = std::make_shared<const INIReader>(filename_);
+            if (reader->ParseError() != 0)
+            {
+                DLL_LOG_WARN(MODULE_NAME) << "配置文件解析失败,保留当前配置:" << filename_ << ",错误:"
+                    << reader->ParseError();
+                return false;
+            }
+            previous = snapshot();
+            changed = previous->ChangedSections(*reader);
+            if (changed.empty())
+            {
+                return false;
+            }
+            current = std::move(reader);
+            std::atomic_store(&snapshot_, current);
+        }
+        DLL_LOG_INFO(MODULE_NAME) << "配置已重新加载:" << filename_ << ",变化的节数:" << static_cast<int>(changed.size());
+
+        std::vector<std::pair<std::string, SectionCallback>> callbacks;
+        {
+            std::lock_guard callbackLock(callbackMutex_);
+            callbacks = callbacks_;
+        }
+        for (const auto& section : changed)
+        {
+            for (const auto& [name, callback] : callbacks)
+            {
+                if (name.empty() || equalsIgnoreCase(name, section))
+                {
+                    try
+                    {
+                        callback(section, previous, current);
+                    }
+                    catch (const std::exception& e)
+                    {
+                        DLL_LOG_ERROR(MODULE_NAME) << "配置变化回调异常,节名:" << section << "," << e.what();
+                    }
+                }
+            }
+        }
+        return true;
+    }
+
+    void stop()
+    {
+        bool stopping;
+        {
+            std::lock_guard lock(stateMutex_);
+            stopping = running_;
+            running_ = false;
+        }
+        if (stopping)
+        {
+            stateCondition_.notify_all();
+#ifdef __linux__
+            if (wakeFd_ >= 0)
+            {
+                const uint64_t one = 1;
+                [[maybe_unused]] const auto written = write(wakeFd_, &one, sizeof(one));
+            }
+#endif
+            DLL_LOG_TRACE(MODULE_NAME) << "停止监听配置文件:" << filename_;
+        }
+        // 在回调中调用时监听线程返回后自行退出,线程在之后的stop或析构时回收
+        if (std::this_thread::get_id() == thread_.get_id())
+        {
+            return;
+        }
+        if (thread_.joinable())
+        {
+            thread_.join();
+        }
+#ifdef __linux__
+        closeNotify();
+#endif
+    }
+
+private:
+    const std::string filename_;
+    const int pollIntervalMs_;
+    Snapshot snapshot_; // 只通过std::atomic_load/atomic_store访问
+    std::mutex reloadMutex_;
+    std::mutex callbackMutex_;
+    std::vector<std::pair<std::string, SectionCallback>> callbacks_;
+
+    std::mutex stateMutex_;
+    std::condition_variable stateCondition_;
+    bool running_ = false;
+    std::thread thread_;
+#ifdef __linux__
+    int notifyFd_ = -1;
+    int wakeFd_ = -1;
+#endif
+
+    static bool equalsIgnoreCase(const std::string& a, const std::string& b)
+    {
+        return a.size() == b.size() && std::equal(a.begin(), a.end(), b.begin(), [](const char x, const char y)
+        {
+            return std::tolower(static_cast<unsigned char>(x)) == std::tolower(static_cast<unsigned char>(y));
+        });
+    }
+
+    void start()
+    {
+        running_ = true;
+#ifdef __linux__
+        if (openNotify())
+        {
+            thread_ = std::thread(&Impl::notifyLoop, this);
+            DLL_LOG_TRACE(MODULE_NAME) << "使用inotify监听配置文件:" << filename_;
+            return;
+        }
+        DLL_LOG_WARN(MODULE_NAME) << "inotify不可用,改为定时检查配置文件:" << filename_;
+#endif
+        thread_ = std::thread(&Impl::pollLoop, this);
+    }
+
+    // 修改时间和大小,文件不存在时为空
+    [[nodiscard]] std::pair<fs::file_time_type, uintmax_t> fileStamp() const
+    {
+        std::error_code error;
+        const auto time = fs::last_write_time(filename_, error);
+        const auto size = error ? 0 : fs::file_size(filename_, error);
+        return error ? std::pair<fs::file_time_type, uintmax_t>{} : std::make_pair(time, size);
+    }
+
+    void pollLoop()
+    {
+        auto stamp = fileStamp();
+        std::unique_lock lock(stateMutex_);
+        while (!stateCondition_.wait_for(lock, std::chrono::milliseconds(pollIntervalMs_), [this] { return !running_; }))
+        {
+            lock.unlock();
+            if (const auto current = fileStamp(); current != stamp)
+            {
+                stamp = current;
+                reload();
+            }
+            lock.lock();
+        }
+    }
+
+#ifdef __linux__
+    // 监听文件所在的目录: 编辑器保存时通常写入临时文件再重命名, 直接监听文件会丢失后续的修改
+    bool openNotify()
+    {
+        const fs::path path(filename_);
+        const std::string directory = path.has_parent_path() ? path.parent_path().string() : ".";
+        notifyFd_ = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        wakeFd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        if (notifyFd_ < 0 || wakeFd_ < 0 ||
+            inotify_add_watch(notifyFd_, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO) < 0)
+        {
+            closeNotify();
+            return false;
+        }
+        return true;
+    }
+
+    void closeNotify()
+    {
+        if (notifyFd_ >= 0)
+            close(notifyFd_);
+        if (wakeFd_ >= 0)
+            close(wakeFd_);
+        notifyFd_ = wakeFd_ = -1;
+    }
+
+    // 读出所有待处理的事件,返回其中是否有监听的文件
+    bool drainEvents() const
+    {
+        const std::string name = fs::path(filename_).filename().string();
+        alignas(inotify_event) char buffer[16 * 1024];
+        bool matched = false;
+        ssize_t length;
+        while ((length = read(notifyFd_, buffer, sizeof(buffer))) > 0)
+        {
+            for (ssize_t offset = 0; offset < length;)
+            {
+                const auto* event = reinterpret_cast<const inotify_event*>(buffer + offset);
+                matched = matched || (event->len > 0 && name == event->name);
+                offset += static_cast<ssize_t>(sizeof(inotify_event) + event->len);
+            }
+        }
+        return matched;
+    }
+
+    void notifyLoop()
+    {
+        pollfd fds[2] = {{notifyFd_, POLLIN, 0}, {wakeFd_, POLLIN, 0}};
+        while (true)
+        {
+            if (poll(fds, 2, -1) < 0 && errno != EINTR)
+            {
+                DLL_LOG_ERROR(MODULE_NAME) << "监听配置文件失败:" << filename_;
+                return;
+            }
+            if (fds[1].revents & POLLIN)
+            {
+                return;
+            }
+            if (!(fds[0].revents & POLLIN) || !drainEvents())
+            {
+                continue;
+            }
+            // 合并短时间内连续的修改,只重新加载一次
+            while (poll(fds, 1, 50) > 0 && (fds[0].revents & POLLIN))
+            {
+                drainEvents();
+            }
+            reload();
+        }
+    }
+#endif
+};
+
+INIWatcher::INIWatcher(const std::string& filename, const int pollIntervalMs):
+    impl_(new Impl(filename, pollIntervalMs))
+{
+}
+
+INIWatcher::~INIWatcher()
+{
+    delete impl_;
+}
+
+INIWatcher::Snapshot INIWatcher::snapshot() const
+{
+    return impl_->snapshot();
+}
+
+void INIWatcher::onSectionChanged(const std::string& section, const SectionCallback& callback) const
+{
+    impl_->onSectionChanged(section, callback);
+}
+
+bool INIWatcher::reload() const
+{
+    return impl_->reload();
+}
+
+void INIWatcher::stop() const
+{
+    impl_->stop();
+}
@@ -7,6 +7,7 @@
 # @Desc     : multi_rtsp_manager.cpp
 */
 #include "include/jade_tools.h"
+#include <algorithm>
 #include <mutex>
 #include <opencv2/core/utils/logger.hpp>
 #include <utility>
@@ -65,6 +66,27 @@ public:
         capture->start();
         captures.push_back(capture);
     }
+
+    bool removeStream(const std::string& ip_address)
+    {
+        std::shared_ptr<RtspVideoCapture> removed;
+        {
+            std::lock_guard lock(mutex);
+            const auto it = std::find_if(captures.begin(), captures.end(), [&ip_address](const auto& capture)
+            {
+                return capture->getRtspIpAddress() == ip_address;
+            });
+            if (it == captures.end())
+            {
+                return false;
+            }
+            removed = *it;
+            captures.erase(it);
+        }
+        removed->stop();
+        DLL_LOG_TRACE(MODULE_NAME) << "移除流成功,ip地址为:" << ip_address;
+        return true;
+    }
     ~Impl()
     {
         for (const auto& capture : captures)
@@ -159,6 +181,10 @@ void MultiRtspManager::addStream(const RtspVideoCapture::RtspInfo& rtsp_info) co
     }
 }
 
+bool MultiRtspManager::removeStream(const std::string& ip_address) const
+{
+    return impl_ && impl_->removeStream(ip_address);
+}
 
 void MultiRtspManager::stopAll()
 {
@@ -284,3 +284,27 @@ std::string RtspVideoCapture::RtspInfo::getCameraName() const
 }
 
 
+
+std::vector<RtspVideoCapture::RtspInfo> RtspVideoCapture::RtspInfo::fromXml(const XmlReader& reader,
+                                                                            const std::string& path)
+{
+    std::vector<RtspInfo> infos;
+    for (const XmlReader::Node& node : reader.select(path))
+    {
+        // 属性优先,没有时取同名子元素
+        const auto field = [&node](const std::string& name, const auto& default_value)
+        {
+            return node.get("@" + name, node.get(name, default_value));
+        };
+        const std::string ip = field("ip", std::string());
+        if (ip.empty())
+        {
+            continue;
+        }
+        infos.emplace_back(field("name", std::string()), field("user", std::string()),
+                           field("password", std::string()), ip, field("port", 554), field("path", std::string()),
+                           field("use_gpu", false), field("frame_interval", 5));
+        infos.back().setDeviceTypeFromString(field("type", std::string()));
+    }
+    return infos;
+}
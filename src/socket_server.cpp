@@ -9,34 +9,245 @@
 #include <algorithm>
 #include <thread>
 #include <mutex>
+#include <memory>
 #include <utility>
 #include <vector>
+#include <unordered_map>
 #include <functional>
+#include <condition_variable>
 #include <atomic>
+#include <cstdint>
+#include <cerrno>
 #ifdef _WIN32
     #include <winsock2.h>
     #include <ws2tcpip.h>
     #pragma comment(lib, "ws2_32.lib")
 #define INVALID_SOCKET_TYPE INVALID_SOCKET
 #define SOCKET_ERROR_TYPE SOCKET_ERROR
+#define SHUTDOWN_BOTH SD_BOTH
+#define SHUTDOWN_READ SD_RECEIVE
+#define SEND_FLAGS 0
 #else
 #include <sys/socket.h>
+#include <sys/uio.h>
 #include <netinet/in.h>
 #include <unistd.h>
 #include <arpa/inet.h>
 #define INVALID_SOCKET_TYPE (-1)
 #define SOCKET_ERROR_TYPE (-1)
+#define SHUTDOWN_BOTH SHUT_RDWR
+#define SHUTDOWN_READ SHUT_RD
+#define SEND_FLAGS MSG_NOSIGNAL
 #endif
 #include "include/jade_tools.h"
 #define MODULE_NAME "SocketServer"
 using namespace jade;
 
+namespace
+{
+    int64_t steadyMillis()
+    {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    int64_t steadyMicros()
+    {
+        return std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    // 统计计数器,每个连接/UDP接收线程各持有一份,只有所属线程写入,读取时汇总
+    struct Counters
+    {
+        std::atomic<uint64_t> bytesIn{0};
+        std::atomic<uint64_t> bytesOut{0};
+        std::atomic<uint64_t> messagesIn{0};
+        std::atomic<uint64_t> messagesOut{0};
+        std::atomic<uint64_t> framingErrors{0};
+        std::atomic<uint64_t> rttTotalUs{0};
+        std::atomic<uint64_t> rttCount{0};
+        std::atomic<uint64_t> lastRttUs{0};
+        std::atomic<int64_t> requestStartUs{0}; // 最早一个未响应请求的到达时间,0表示没有
+        std::atomic<int> inHandler{0};
+
+        static void add(std::atomic<uint64_t>& counter, const uint64_t value)
+        {
+            counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+        }
+    };
+
+    // 已关闭连接的累计值,由clientsMutex_保护
+    struct Totals
+    {
+        uint64_t bytesIn = 0;
+        uint64_t bytesOut = 0;
+        uint64_t messagesIn = 0;
+        uint64_t messagesOut = 0;
+        uint64_t framingErrors = 0;
+
+        void add(const Counters& counters)
+        {
+            bytesIn += counters.bytesIn.load(std::memory_order_relaxed);
+            bytesOut += counters.bytesOut.load(std::memory_order_relaxed);
+            messagesIn += counters.messagesIn.load(std::memory_order_relaxed);
+            messagesOut += counters.messagesOut.load(std::memory_order_relaxed);
+            framingErrors += counters.framingErrors.load(std::memory_order_relaxed);
+        }
+    };
+
+    constexpr size_t kFrameHeaderSize = 4;
+
+    uint32_t readFrameLength(const char* data)
+    {
+        const auto* bytes = reinterpret_cast<const unsigned char*>(data);
+        return static_cast<uint32_t>(bytes[0]) << 24 | static_cast<uint32_t>(bytes[1]) << 16 |
+            static_cast<uint32_t>(bytes[2]) << 8 | static_cast<uint32_t>(bytes[3]);
+    }
+
+    // 槽位表: 连接id由 (代数 << 32 | 下标) 组成,插入/删除/查找均为O(1),
+    // 槽位复用时代数递增,旧id不会误命中新连接
+    template <typename T>
+    class SlotMap
+    {
+    public:
+        uint64_t insert(T value)
+        {
+            uint32_t index;
+            if (!freeList_.empty())
+            {
+                index = freeList_.back();
+                freeList_.pop_back();
+            }
+            else
+            {
+                index = static_cast<uint32_t>(slots_.size());
+                slots_.emplace_back();
+            }
+            Slot& slot = slots_[index];
+            slot.value = std::move(value);
+            slot.occupied = true;
+            ++size_;
+            return static_cast<uint64_t>(slot.generation) << 32 | index;
+        }
+
+        T* find(const uint64_t id)
+        {
+            const auto index = static_cast<uint32_t>(id & 0xFFFFFFFF);
+            if (index >= slots_.size())
+                return nullptr;
+            Slot& slot = slots_[index];
+            if (!slot.occupied || slot.generation != static_cast<uint32_t>(id >> 32))
+                return nullptr;
+            return &slot.value;
+        }
+
+        bool erase(const uint64_t id)
+        {
+            if (!find(id))
+                return false;
+            const auto index = static_cast<uint32_t>(id & 0xFFFFFFFF);
+            Slot& slot = slots_[index];
+            slot.value = T{};
+            slot.occupied = false;
+            ++slot.generation;
+            freeList_.push_back(index);
+            --size_;
+            return true;
+        }
+
+        template <typename Func>
+        void forEach(Func&& func)
+        {
+            for (auto& slot : slots_)
+            {
+                if (slot.occupied)
+                    func(slot.value);
+            }
+        }
+
+        [[nodiscard]] size_t size() const { return size_; }
+
+    private:
+        struct Slot
+        {
+            T value{};
+            uint32_t generation = 0;
+            bool occupied = false;
+        };
+
+        std::vector<Slot> slots_;
+        std::vector<uint32_t> freeList_;
+        size_t size_ = 0;
+    };
+
+    // 哈希时间轮: 每个tick推进一个槽位,超出一圈的定时器记录剩余圈数
+    class TimerWheel
+    {
+    public:
+        TimerWheel(const int tickMs, const size_t slotCount): tickMs_(tickMs), slots_(slotCount)
+        {
+        }
+
+        void schedule(const uint64_t id, const int64_t delayMs)
+        {
+            const auto ticks = static_cast<size_t>(std::max<int64_t>(1, (delayMs + tickMs_ - 1) / tickMs_));
+            slots_[(cursor_ + ticks) % slots_.size()].push_back({id, (ticks - 1) / slots_.size()});
+        }
+
+        // 推进一个tick,返回到期的id
+        std::vector<uint64_t> advance()
+        {
+            cursor_ = (cursor_ + 1) % slots_.size();
+            std::vector<uint64_t> expired;
+            auto& bucket = slots_[cursor_];
+            for (size_t i = 0; i < bucket.size();)
+            {
+                if (bucket[i].rounds == 0)
+                {
+                    expired.push_back(bucket[i].id);
+                    bucket[i] = bucket.back();
+                    bucket.pop_back();
+                }
+                else
+                {
+                    --bucket[i].rounds;
+                    ++i;
+                }
+            }
+            return expired;
+        }
+
+        [[nodiscard]] int tickMs() const { return tickMs_; }
+
+        // 丢弃所有未到期的定时器
+        void clear()
+        {
+            for (auto& bucket : slots_)
+                bucket.clear();
+            cursor_ = 0;
+        }
+
+    private:
+        struct Entry
+        {
+            uint64_t id;
+            size_t rounds;
+        };
+
+        int tickMs_;
+        size_t cursor_ = 0;
+        std::vector<std::vector<Entry>> slots_;
+    };
+}
+
 class SocketServer::Impl final
 {
 public:
 
-    explicit Impl(const int port, MessageHandler callback):
-        port_(port), serverSocket_(0), running_(false), callback_(std::move(callback))
+    explicit Impl(const int port, MessageHandler callback, PeerMessageHandler peerCallback, const Options& options):
+        port_(port), serverSocket_(0), running_(false), wheel_(kTickMs, kWheelSlots), callback_(std::move(callback)),
+        peerCallback_(std::move(peerCallback)), options_(options)
     {
 #ifdef _WIN32
         WSADATA wsaData;
@@ -55,11 +266,17 @@ public:
         if (running_)
             return;
         running_ = true;
+        if (options_.transport == Transport::UDP)
+        {
+            startUdp();
+            return;
+        }
         // 创建监听套接字
         serverSocket_ = socket(AF_INET, SOCK_STREAM, 0);
         if (serverSocket_ == INVALID_SOCKET_TYPE)
         {
             DLL_LOG_ERROR(MODULE_NAME) << "Failed to create socket";
+            running_ = false;
             throw std::runtime_error("Failed to create socket");
         }
 
@@ -68,11 +285,17 @@ public:
         serverAddr.sin_family = AF_INET;
         serverAddr.sin_port = htons(port_);
         serverAddr.sin_addr.s_addr = INADDR_ANY;
+#ifndef _WIN32
+        // 允许重启时立即重新绑定仍处于TIME_WAIT的端口
+        int reuse = 1;
+        setsockopt(serverSocket_, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+#endif
 
         if (bind(serverSocket_, reinterpret_cast<sockaddr*>(&serverAddr), sizeof(serverAddr)) == SOCKET_ERROR_TYPE)
         {
             closeSocket(serverSocket_);
             DLL_LOG_CRITICAL(MODULE_NAME, -101) << "绑定端口失败,当前端口为:" << port_ << "请更换端口;";
+            running_ = false;
             throw std::runtime_error("bind failed");
         }
         // 监听连接
@@ -80,48 +303,494 @@ public:
         {
             closeSocket(serverSocket_);
             DLL_LOG_CRITICAL(MODULE_NAME, -102) << "监听端口失败";
+            running_ = false;
             throw std::runtime_error("Listen failed");
         }
         DLL_LOG_INFO(MODULE_NAME) << "Socket服务已启动,监听端口号为:" << port_ << " ...";
         // 启动接受连接的线程
         acceptThread_ = std::thread(&Impl::acceptConnections, this);
+        // 启用了超时才需要时间轮线程
+        if (options_.readIdleTimeoutMs > 0 || options_.writeTimeoutMs > 0)
+        {
+            timerThread_ = std::thread(&Impl::timerLoop, this);
+        }
     }
 
-    ~ Impl()
+    bool send(const SOCKET_TYPE client, const char* data, const size_t size)
+    {
+        std::shared_ptr<Connection> connection;
+        {
+            std::lock_guard lock(clientsMutex_);
+            const auto it = socketIndex_.find(client);
+            if (it != socketIndex_.end())
+            {
+                if (const auto found = connections_.find(it->second))
+                    connection = *found;
+            }
+        }
+        if (!connection)
+        {
+            DLL_LOG_WARN(MODULE_NAME) << "发送失败,客户端连接不存在:" << client;
+            return false;
+        }
+
+        std::lock_guard writeLock(connection->writeMutex);
+        if (connection->closed)
+        {
+            return false;
+        }
+        connection->writeStartMs = steadyMillis();
+        bool success;
+        if (options_.framing == Framing::LENGTH_PREFIXED)
+        {
+            if (size > UINT32_MAX)
+            {
+                DLL_LOG_ERROR(MODULE_NAME) << "消息长度超出帧长度范围";
+                connection->writeStartMs = 0;
+                return false;
+            }
+            // 长度头和消息体一次写入,分两次写入时消息体会被Nagle算法推迟到长度头的ACK之后
+            const auto length = static_cast<uint32_t>(size);
+            std::string frame = {
+                static_cast<char>(length >> 24), static_cast<char>(length >> 16),
+                static_cast<char>(length >> 8), static_cast<char>(length)
+            };
+            frame.append(data, size);
+            success = sendAll(client, frame.data(), frame.size());
+        }
+        else
+        {
+            success = sendAll(client, data, size);
+        }
+        connection->writeStartMs = 0;
+        // 只统计发送成功的消息,失败时保留未响应的请求时刻
+        if (success)
+        {
+            Counters& counters = connection->counters;
+            Counters::add(counters.bytesOut, options_.framing == Framing::LENGTH_PREFIXED ? size + kFrameHeaderSize : size);
+            Counters::add(counters.messagesOut, 1);
+            // 请求/响应往返时间: 从收到最早一个未响应的消息到本次发送完成
+            if (const int64_t requestStart = counters.requestStartUs.exchange(0); requestStart > 0)
+            {
+                const auto rtt = static_cast<uint64_t>(steadyMicros() - requestStart);
+                counters.lastRttUs.store(rtt, std::memory_order_relaxed);
+                Counters::add(counters.rttTotalUs, rtt);
+                Counters::add(counters.rttCount, 1);
+            }
+        }
+        return success;
+    }
+
+    bool sendTo(const SOCKET_TYPE socket, const PeerAddress& peer, const char* data, const size_t size)
+    {
+        sockaddr_in address{};
+        address.sin_family = AF_INET;
+        address.sin_port = htons(peer.port);
+        address.sin_addr.s_addr = htonl(peer.ip);
+        const int n = ::sendto(socket, data, static_cast<int>(size), SEND_FLAGS,
+                               reinterpret_cast<sockaddr*>(&address), sizeof(address));
+        if (n < 0)
+        {
+            printError("Send to failed");
+            return false;
+        }
+        udpSendBytes_.fetch_add(n, std::memory_order_relaxed);
+        udpSendMessages_.fetch_add(1, std::memory_order_relaxed);
+        return static_cast<size_t>(n) == size;
+    }
+
+    // 优雅停止: 先停止接受新连接,再关闭各连接的读端,让已接收的消息处理完成并发送完毕,
+    // 超过timeoutMs仍未结束的连接强制关闭,最后回收所有线程,停止后可以再次start
+    void stop(const int timeoutMs)
     {
         if (!running_)
             return;
         running_ = false;
-        // 关闭监听套接字
-        closeSocket(serverSocket_);
+        const int64_t begin = steadyMillis();
+        if (options_.transport == Transport::UDP)
+        {
+            stopUdp();
+        }
+        else
+        {
+            // 关闭监听套接字,等待接受连接线程结束
+            closeSocket(serverSocket_);
+            if (acceptThread_.joinable())
+            {
+                acceptThread_.join();
+            }
 
-        // 等待接受连接线程结束
-        if (acceptThread_.joinable())
+            std::unique_lock lock(clientsMutex_);
+            connections_.forEach([](const std::shared_ptr<Connection>& connection)
+            {
+                shutdown(connection->socket, SHUTDOWN_READ);
+            });
+            if (!drainCondition_.wait_for(lock, std::chrono::milliseconds(std::max(0, timeoutMs)),
+                                          [this] { return handlerThreads_.empty(); }))
+            {
+                DLL_LOG_WARN(MODULE_NAME) << "等待连接处理超时,强制关闭剩余连接:"
+                    << static_cast<int>(handlerThreads_.size());
+                connections_.forEach([](const std::shared_ptr<Connection>& connection)
+                {
+                    shutdown(connection->socket, SHUTDOWN_BOTH);
+                });
+            }
+            lock.unlock();
+            joinHandlers(true);
+        }
+        timerCondition_.notify_all();
+        if (timerThread_.joinable())
         {
-            acceptThread_.join();
+            timerThread_.join();
         }
 
-        // 关闭所有客户端连接
+        // 槽位表重置后连接id会从头分配,残留的定时器可能匹配到重启后的新连接
+        std::lock_guard lock(clientsMutex_);
+        wheel_.clear();
+        connections_ = {};
+        socketIndex_.clear();
+        ipCounts_.clear();
+        DLL_LOG_TRACE(MODULE_NAME) << "停止Socket服务完成,耗时:" << static_cast<int>(steadyMillis() - begin) << "ms ...";
+    }
+
+    [[nodiscard]] bool isRunning() const
+    {
+        return running_;
+    }
+
+    [[nodiscard]] Stats getStats(const bool withConnections)
+    {
+        Stats stats;
+        const auto collect = [&stats](const Counters& counters)
+        {
+            stats.bytesIn += counters.bytesIn.load(std::memory_order_relaxed);
+            stats.bytesOut += counters.bytesOut.load(std::memory_order_relaxed);
+            stats.messagesIn += counters.messagesIn.load(std::memory_order_relaxed);
+            stats.messagesOut += counters.messagesOut.load(std::memory_order_relaxed);
+            stats.framingErrors += counters.framingErrors.load(std::memory_order_relaxed);
+            stats.activeHandlers += counters.inHandler.load(std::memory_order_relaxed);
+        };
+        const int64_t now = steadyMillis();
         std::lock_guard lock(clientsMutex_);
-        for (const auto client : clients_)
+        stats.bytesIn = retired_.bytesIn;
+        stats.bytesOut = retired_.bytesOut + udpSendBytes_.load(std::memory_order_relaxed);
+        stats.messagesIn = retired_.messagesIn;
+        stats.messagesOut = retired_.messagesOut + udpSendMessages_.load(std::memory_order_relaxed);
+        stats.framingErrors = retired_.framingErrors;
+        stats.activeConnections = connections_.size();
+        stats.totalConnections = totalConnections_;
+        stats.rejectedConnections = rejectedConnections_;
+        stats.timestampMs = now;
+        for (const auto& counters : udpCounters_)
         {
-            closeSocket(client);
+            collect(*counters);
         }
-        clients_.clear();
+        connections_.forEach([&](const std::shared_ptr<Connection>& connection)
+        {
+            const Counters& counters = connection->counters;
+            collect(counters);
+            if (!withConnections)
+                return;
+            ConnectionStats item;
+            item.id = connection->id;
+            item.socket = connection->socket;
+            item.peer = {connection->ip, connection->port};
+            item.bytesIn = counters.bytesIn.load(std::memory_order_relaxed);
+            item.bytesOut = counters.bytesOut.load(std::memory_order_relaxed);
+            item.messagesIn = counters.messagesIn.load(std::memory_order_relaxed);
+            item.messagesOut = counters.messagesOut.load(std::memory_order_relaxed);
+            item.lastRttMs = static_cast<double>(counters.lastRttUs.load(std::memory_order_relaxed)) / 1000.0;
+            if (const uint64_t count = counters.rttCount.load(std::memory_order_relaxed))
+            {
+                item.avgRttMs = static_cast<double>(counters.rttTotalUs.load(std::memory_order_relaxed)) / 1000.0 /
+                    static_cast<double>(count);
+            }
+            stats.connections.push_back(item);
+        });
+        return stats;
+    }
+
+    ~ Impl()
+    {
+        stop(0);
 #ifdef _WIN32
         WSACleanup();
 #endif
-        DLL_LOG_TRACE(MODULE_NAME) << "停止Socket服务完成 ...";
     }
 
 private:
+    static constexpr int kTickMs = 100;
+    static constexpr size_t kWheelSlots = 512;
+
+    struct Connection
+    {
+        SOCKET_TYPE socket{};
+        uint32_t ip = 0;
+        uint16_t port = 0;
+        std::atomic<int64_t> lastReadMs{0}; // 最近一次收到数据的时间
+        std::atomic<int64_t> writeStartMs{0}; // 当前send开始的时间,0表示没有正在进行的写
+        std::mutex writeMutex;
+        bool closed = false; // 由writeMutex保护,关闭后不再允许写入
+        uint64_t id = 0;
+        Counters counters;
+    };
+
     int port_;
     SOCKET_TYPE serverSocket_;
     std::atomic<bool> running_;
     std::thread acceptThread_;
-    std::vector<SOCKET_TYPE> clients_;
+    std::thread timerThread_;
+    std::mutex timerMutex_;
+    std::condition_variable timerCondition_;
+    // 以下成员均由clientsMutex_保护
+    SlotMap<std::shared_ptr<Connection>> connections_;
+    std::unordered_map<SOCKET_TYPE, uint64_t> socketIndex_;
+    std::unordered_map<uint32_t, size_t> ipCounts_;
+    std::unordered_map<uint64_t, std::thread> handlerThreads_; // 仍在运行的连接处理线程
+    std::vector<std::thread> finishedThreads_; // 已退出待回收的处理线程
+    std::condition_variable drainCondition_;
+    TimerWheel wheel_;
     std::mutex clientsMutex_;
+    Totals retired_;
+    uint64_t totalConnections_ = 0;
+    uint64_t rejectedConnections_ = 0;
+    std::vector<std::unique_ptr<Counters>> udpCounters_;
+    std::vector<SOCKET_TYPE> udpSockets_;
+    std::vector<std::thread> udpThreads_;
+    std::atomic<uint64_t> udpSendBytes_{0};
+    std::atomic<uint64_t> udpSendMessages_{0};
     MessageHandler callback_;
+    PeerMessageHandler peerCallback_;
+    Options options_;
+
+    void dispatch(const SOCKET_TYPE socket, char* data, const size_t size, const PeerAddress& peer,
+                  Counters& counters) const
+    {
+        Counters::add(counters.messagesIn, 1);
+        if (counters.requestStartUs.load(std::memory_order_relaxed) == 0)
+        {
+            counters.requestStartUs.store(steadyMicros(), std::memory_order_relaxed);
+        }
+        counters.inHandler.store(1, std::memory_order_relaxed);
+        if (peerCallback_)
+        {
+            peerCallback_(socket, data, size, peer);
+        }
+        else if (callback_)
+        {
+            callback_(socket, data, size);
+        }
+        counters.inHandler.store(0, std::memory_order_relaxed);
+    }
+
+    static bool sendAll(const SOCKET_TYPE client, const char* data, const size_t size)
+    {
+        size_t sent = 0;
+        while (sent < size)
+        {
+            const int n = ::send(client, data + sent, static_cast<int>(size - sent), SEND_FLAGS);
+            if (n <= 0)
+            {
+                printError("Send failed");
+                return false;
+            }
+            sent += n;
+        }
+        return true;
+    }
+
+    void startUdp()
+    {
+        const int socketCount = std::max(1, options_.udpSocketCount);
+        for (int i = 0; i < socketCount; ++i)
+        {
+            const SOCKET_TYPE udpSocket = socket(AF_INET, SOCK_DGRAM, 0);
+            if (udpSocket == INVALID_SOCKET_TYPE)
+            {
+                DLL_LOG_ERROR(MODULE_NAME) << "Failed to create socket";
+                running_ = false;
+                stopUdp();
+                throw std::runtime_error("Failed to create socket");
+            }
+            int enable = 1;
+#ifdef SO_REUSEPORT
+            // 多个socket绑定同一端口,由内核按四元组哈希分发数据报
+            if (socketCount > 1)
+            {
+                setsockopt(udpSocket, SOL_SOCKET, SO_REUSEPORT, reinterpret_cast<const char*>(&enable), sizeof(enable));
+            }
+#else
+            if (socketCount > 1 && i == 0)
+            {
+                DLL_LOG_WARN(MODULE_NAME) << "当前平台不支持SO_REUSEPORT,UDP仅使用单个socket";
+            }
+#endif
+            if (options_.receiveBufferBytes > 0)
+            {
+                setsockopt(udpSocket, SOL_SOCKET, SO_RCVBUF, reinterpret_cast<const char*>(&options_.receiveBufferBytes),
+                           sizeof(options_.receiveBufferBytes));
+            }
+            sockaddr_in serverAddr{};
+            serverAddr.sin_family = AF_INET;
+            serverAddr.sin_port = htons(port_);
+            serverAddr.sin_addr.s_addr = INADDR_ANY;
+            if (bind(udpSocket, reinterpret_cast<sockaddr*>(&serverAddr), sizeof(serverAddr)) == SOCKET_ERROR_TYPE)
+            {
+                closeSocket(udpSocket);
+                stopUdp();
+                DLL_LOG_CRITICAL(MODULE_NAME, -101) << "绑定端口失败,当前端口为:" << port_ << "请更换端口;";
+                running_ = false;
+                throw std::runtime_error("bind failed");
+            }
+            udpSockets_.push_back(udpSocket);
+#ifndef SO_REUSEPORT
+            break;
+#endif
+        }
+        std::lock_guard lock(clientsMutex_);
+        for (const auto udpSocket : udpSockets_)
+        {
+            udpCounters_.push_back(std::make_unique<Counters>());
+            udpThreads_.emplace_back(&Impl::receiveDatagrams, this, udpSocket, udpCounters_.back().get());
+        }
+        DLL_LOG_INFO(MODULE_NAME) << "UDP服务已启动,监听端口号为:" << port_ << ",接收socket数量:"
+            << static_cast<int>(udpSockets_.size());
+    }
+
+    // 先shutdown唤醒阻塞在接收上的线程,等线程退出后再close,避免线程读到被重新分配的描述符
+    void stopUdp()
+    {
+#ifndef _WIN32
+        for (const auto udpSocket : udpSockets_)
+        {
+            shutdown(udpSocket, SHUTDOWN_BOTH);
+        }
+#else
+        // Windows下只有closesocket能中断阻塞的recvfrom
+        for (const auto udpSocket : udpSockets_)
+        {
+            closesocket(udpSocket);
+        }
+#endif
+        for (auto& thread : udpThreads_)
+        {
+            if (thread.joinable())
+                thread.join();
+        }
+#ifndef _WIN32
+        for (const auto udpSocket : udpSockets_)
+        {
+            close(udpSocket);
+        }
+#endif
+        udpThreads_.clear();
+        udpSockets_.clear();
+        std::lock_guard lock(clientsMutex_);
+        for (const auto& counters : udpCounters_)
+        {
+            retired_.add(*counters);
+        }
+        udpCounters_.clear();
+    }
+
+    // 接收数据报,Linux下使用recvmmsg批量接收到预分配的缓冲区
+    void receiveDatagrams(const SOCKET_TYPE udpSocket, Counters* counters) const
+    {
+        const size_t datagramSize = std::max(1, options_.udpDatagramSize);
+#ifdef __linux__
+        const size_t batchSize = std::max(1, options_.udpBatchSize);
+        std::vector<char> storage(batchSize * datagramSize);
+        std::vector<iovec> iovecs(batchSize);
+        std::vector<sockaddr_in> addresses(batchSize);
+        std::vector<mmsghdr> messages(batchSize);
+        for (size_t i = 0; i < batchSize; ++i)
+        {
+            iovecs[i].iov_base = storage.data() + i * datagramSize;
+            iovecs[i].iov_len = datagramSize;
+            messages[i].msg_hdr.msg_iov = &iovecs[i];
+            messages[i].msg_hdr.msg_iovlen = 1;
+            messages[i].msg_hdr.msg_name = &addresses[i];
+        }
+        while (running_)
+        {
+            for (auto& message : messages)
+            {
+                message.msg_hdr.msg_namelen = sizeof(sockaddr_in);
+                message.msg_hdr.msg_flags = 0;
+            }
+            // MSG_WAITFORONE: 至少收到一个数据报后不再阻塞,返回当前已就绪的全部数据报
+            const int count = recvmmsg(udpSocket, messages.data(), static_cast<unsigned int>(batchSize), MSG_WAITFORONE,
+                                       nullptr);
+            if (count < 0)
+            {
+                if (running_ && errno != EINTR)
+                {
+                    printError("Receive failed");
+                }
+                continue;
+            }
+            for (int i = 0; i < count; ++i)
+            {
+                // shutdown后recvmmsg返回一个长度为0的空消息,不是真实的数据报
+                if (messages[i].msg_len == 0 && !running_)
+                {
+                    continue;
+                }
+                if (messages[i].msg_hdr.msg_flags & MSG_TRUNC)
+                {
+                    DLL_LOG_WARN(MODULE_NAME) << "数据报超过缓冲区大小被截断:" << static_cast<int>(datagramSize);
+                    Counters::add(counters->framingErrors, 1);
+                }
+                Counters::add(counters->bytesIn, messages[i].msg_len);
+                const PeerAddress peer{ntohl(addresses[i].sin_addr.s_addr), ntohs(addresses[i].sin_port)};
+                dispatch(udpSocket, static_cast<char*>(iovecs[i].iov_base), messages[i].msg_len, peer, *counters);
+            }
+        }
+#else
+        std::vector<char> buffer(datagramSize);
+        while (running_)
+        {
+            sockaddr_in address{};
+            socklen_t addressLen = sizeof(address);
+            const int n = recvfrom(udpSocket, buffer.data(), static_cast<int>(buffer.size()), 0,
+                                   reinterpret_cast<sockaddr*>(&address), &addressLen);
+            if (n < 0 || (n == 0 && !running_))
+            {
+                if (n < 0 && running_)
+                {
+                    printError("Receive failed");
+                }
+                continue;
+            }
+            Counters::add(counters->bytesIn, n);
+            const PeerAddress peer{ntohl(address.sin_addr.s_addr), ntohs(address.sin_port)};
+            dispatch(udpSocket, buffer.data(), n, peer, *counters);
+        }
+#endif
+    }
+
+    // 回收已退出的处理线程,all为true时回收全部线程
+    void joinHandlers(const bool all)
+    {
+        std::vector<std::thread> threads;
+        {
+            std::lock_guard lock(clientsMutex_);
+            threads.swap(finishedThreads_);
+            if (all)
+            {
+                for (auto& [id, thread] : handlerThreads_)
+                {
+                    threads.push_back(std::move(thread));
+                }
+                handlerThreads_.clear();
+            }
+        }
+        for (auto& thread : threads)
+        {
+            if (thread.joinable())
+                thread.join();
+        }
+    }
 
     void acceptConnections()
     {
@@ -147,27 +816,61 @@ private:
             inet_ntop(AF_INET, &(clientAddr.sin_addr), clientIP, INET_ADDRSTRLEN);
             DLL_LOG_DEBUG(MODULE_NAME) << "客户端连接 " << clientIP << ":" << ntohs(clientAddr.sin_port);
 
-            // 添加客户端到列表
+            // 添加客户端到槽位表,超出连接数限制时直接拒绝
+            const auto connection = std::make_shared<Connection>();
+            connection->socket = clientSocket;
+            connection->ip = ntohl(clientAddr.sin_addr.s_addr);
+            connection->port = ntohs(clientAddr.sin_port);
+            connection->lastReadMs = steadyMillis();
+            uint64_t id;
             {
                 std::lock_guard lock(clientsMutex_);
-                clients_.push_back(clientSocket);
+                if (options_.maxConnections > 0 && connections_.size() >= options_.maxConnections)
+                {
+                    DLL_LOG_WARN(MODULE_NAME) << "连接数已达上限:" << static_cast<int>(options_.maxConnections)
+                        << ",拒绝客户端 " << clientIP;
+                    closeSocket(clientSocket);
+                    ++rejectedConnections_;
+                    continue;
+                }
+                size_t& ipCount = ipCounts_[connection->ip];
+                if (options_.maxConnectionsPerIp > 0 && ipCount >= options_.maxConnectionsPerIp)
+                {
+                    DLL_LOG_WARN(MODULE_NAME) << "客户端 " << clientIP << " 连接数已达上限:"
+                        << static_cast<int>(options_.maxConnectionsPerIp);
+                    closeSocket(clientSocket);
+                    ++rejectedConnections_;
+                    continue;
+                }
+                ++ipCount;
+                id = connections_.insert(connection);
+                connection->id = id;
+                ++totalConnections_;
+                socketIndex_[clientSocket] = id;
+                armTimer(id, *connection, steadyMillis());
+                // 为客户端创建处理线程,线程在持锁期间登记,退出时由自身移入回收列表
+                handlerThreads_.emplace(id, std::thread(&Impl::handleClient, this, id, connection));
             }
-
-            // 为客户端创建处理线程
-            std::thread clientThread(&Impl::handleClient, this, clientSocket);
-            clientThread.detach();
+            joinHandlers(false);
         }
     }
 
     // 处理客户端消息
-    void handleClient(const SOCKET_TYPE clientSocket)
+    void handleClient(const uint64_t id, const std::shared_ptr<Connection> connection)
     {
-        char buffer[1024];
+        const SOCKET_TYPE clientSocket = connection->socket;
+        const PeerAddress peer{connection->ip, connection->port};
+        Counters& counters = connection->counters;
+        const bool framed = options_.framing == Framing::LENGTH_PREFIXED;
+        char buffer[4096];
         std::vector<char> messageBuffer;  // 用于累积不完整的消息
-        while (running_)
+        bool framingError = false;
+        // 停止服务时会关闭连接的读端,recv返回0后仍会回调已接收的完整帧;
+        // 不分帧时以对端关闭作为消息结束,停止服务造成的EOF不代表消息完整,已接收的数据被丢弃
+        while (true)
         {
             // 接收数据
-            const int bytesReceived = recv(clientSocket, buffer, sizeof(buffer) - 1, 0);
+            const int bytesReceived = recv(clientSocket, buffer, sizeof(buffer), 0);
 
             if (bytesReceived <= 0)
             {
@@ -181,19 +884,149 @@ private:
                 }
                 break;
             }
+            connection->lastReadMs = steadyMillis();
+            Counters::add(counters.bytesIn, bytesReceived);
 
             // 将新接收的数据追加到消息缓冲区
             messageBuffer.insert(messageBuffer.end(), buffer, buffer + bytesReceived);
+            if (framed)
+            {
+                framingError = !dispatchFrames(clientSocket, messageBuffer, peer, counters);
+            }
+            else if (options_.maxMessageSize > 0 && messageBuffer.size() > options_.maxMessageSize)
+            {
+                framingError = true;
+            }
+            if (framingError)
+            {
+                DLL_LOG_WARN(MODULE_NAME) << "消息长度超出上限:" << static_cast<int>(options_.maxMessageSize)
+                    << ",断开连接:" << clientSocket;
+                messageBuffer.clear();
+                break;
+            }
+        }
+        if (framed && !messageBuffer.empty())
+        {
+            DLL_LOG_WARN(MODULE_NAME) << "连接关闭时存在不完整的帧,丢弃:" << static_cast<int>(messageBuffer.size());
+            framingError = true;
+        }
+        else if (!framed && !messageBuffer.empty() && !running_)
+        {
+            DLL_LOG_WARN(MODULE_NAME) << "服务停止时消息未接收完整,丢弃:" << static_cast<int>(messageBuffer.size());
+        }
+        else if (!framed && !messageBuffer.empty())
+        {
+            dispatch(clientSocket, messageBuffer.data(), messageBuffer.size(), peer, counters);
+        }
+        if (framingError)
+        {
+            Counters::add(counters.framingErrors, 1);
+        }
+        // 等待正在进行的发送完成,之后不再允许写入
+        {
+            std::lock_guard writeLock(connection->writeMutex);
+            connection->closed = true;
         }
-        if (!messageBuffer.empty())
+        // 先从槽位表中移除再关闭,避免句柄被新连接复用后误删
         {
-            callback_(clientSocket, messageBuffer.data(), messageBuffer.size());
+            std::lock_guard lock(clientsMutex_);
+            if (connections_.erase(id))
+            {
+                socketIndex_.erase(clientSocket);
+                if (const auto it = ipCounts_.find(connection->ip); it != ipCounts_.end() && --it->second == 0)
+                {
+                    ipCounts_.erase(it);
+                }
+            }
+            retired_.add(counters);
         }
-        // 关闭客户端连接
         closeSocket(clientSocket);
-        // 从客户端列表中移除
         std::lock_guard lock(clientsMutex_);
-        clients_.erase(std::remove(clients_.begin(), clients_.end(), clientSocket), clients_.end());
+        if (const auto it = handlerThreads_.find(id); it != handlerThreads_.end())
+        {
+            finishedThreads_.push_back(std::move(it->second));
+            handlerThreads_.erase(it);
+        }
+        drainCondition_.notify_all();
+    }
+
+    // 按长度前缀拆分缓冲区中的完整帧并逐个回调,剩余的不完整帧保留在缓冲区中,
+    // 帧长度超出maxMessageSize时返回false
+    bool dispatchFrames(const SOCKET_TYPE clientSocket, std::vector<char>& messageBuffer, const PeerAddress& peer,
+                        Counters& counters) const
+    {
+        size_t offset = 0;
+        bool valid = true;
+        while (messageBuffer.size() - offset >= kFrameHeaderSize)
+        {
+            const uint32_t length = readFrameLength(messageBuffer.data() + offset);
+            if (options_.maxMessageSize > 0 && length > options_.maxMessageSize)
+            {
+                valid = false;
+                break;
+            }
+            if (messageBuffer.size() - offset - kFrameHeaderSize < length)
+                break;
+            dispatch(clientSocket, messageBuffer.data() + offset + kFrameHeaderSize, length, peer, counters);
+            offset += kFrameHeaderSize + length;
+        }
+        messageBuffer.erase(messageBuffer.begin(), messageBuffer.begin() + static_cast<std::ptrdiff_t>(offset));
+        return valid;
+    }
+
+    // 为连接登记下一次超时检查,调用方需持有clientsMutex_
+    void armTimer(const uint64_t id, const Connection& connection, const int64_t now)
+    {
+        int64_t deadline = INT64_MAX;
+        if (options_.readIdleTimeoutMs > 0)
+        {
+            deadline = connection.lastReadMs + options_.readIdleTimeoutMs;
+        }
+        if (options_.writeTimeoutMs > 0)
+        {
+            const int64_t writeStart = connection.writeStartMs;
+            deadline = std::min(deadline, (writeStart ? writeStart : now) + options_.writeTimeoutMs);
+        }
+        if (deadline != INT64_MAX)
+        {
+            wheel_.schedule(id, deadline - now);
+        }
+    }
+
+    void timerLoop()
+    {
+        std::unique_lock timerLock(timerMutex_);
+        while (running_)
+        {
+            timerCondition_.wait_for(timerLock, std::chrono::milliseconds(wheel_.tickMs()));
+            if (!running_)
+                break;
+            const int64_t now = steadyMillis();
+            std::lock_guard lock(clientsMutex_);
+            for (const uint64_t id : wheel_.advance())
+            {
+                // 连接已关闭则定时器自然失效
+                const auto found = connections_.find(id);
+                if (!found)
+                    continue;
+                const auto& connection = *found;
+                const int64_t writeStart = connection->writeStartMs;
+                if (options_.readIdleTimeoutMs > 0 && now - connection->lastReadMs >= options_.readIdleTimeoutMs)
+                {
+                    DLL_LOG_DEBUG(MODULE_NAME) << "客户端读空闲超时,断开连接:" << connection->socket;
+                    shutdown(connection->socket, SHUTDOWN_BOTH);
+                }
+                else if (options_.writeTimeoutMs > 0 && writeStart && now - writeStart >= options_.writeTimeoutMs)
+                {
+                    DLL_LOG_DEBUG(MODULE_NAME) << "客户端写超时,断开连接:" << connection->socket;
+                    shutdown(connection->socket, SHUTDOWN_BOTH);
+                }
+                else
+                {
+                    armTimer(id, *connection, now);
+                }
+            }
+        }
     }
 
     static void printError(const std::string& message)
@@ -218,21 +1051,61 @@ private:
 
 
 
-SocketServer::SocketServer(const int port, const MessageHandler& handler): impl_(new Impl(port, handler))
+SocketServer::SocketServer(const int port, const MessageHandler& handler):
+    impl_(new Impl(port, handler, nullptr, Options()))
+{
+}
+
+SocketServer::SocketServer(const int port, const MessageHandler& handler, const Options& options):
+    impl_(new Impl(port, handler, nullptr, options))
+{
+}
+
+SocketServer::SocketServer(const int port, const PeerMessageHandler& handler, const Options& options):
+    impl_(new Impl(port, nullptr, handler, options))
 {
 }
 
+SocketServer::~SocketServer()
+{
+    delete impl_;
+    impl_ = nullptr;
+}
+
 void SocketServer::start() const
 {
     if (impl_)
         impl_->start();
 }
 
-void SocketServer::stop()
+bool SocketServer::isRunning() const
+{
+    return impl_ && impl_->isRunning();
+}
+
+bool SocketServer::send(const SOCKET_TYPE client, const char* data, const size_t size) const
 {
     if (impl_)
-    {
-        delete impl_;
-        impl_ = nullptr;
-    }
+        return impl_->send(client, data, size);
+    return false;
+}
+
+bool SocketServer::sendTo(const SOCKET_TYPE socket, const PeerAddress& peer, const char* data, const size_t size) const
+{
+    if (impl_)
+        return impl_->sendTo(socket, peer, data, size);
+    return false;
+}
+
+SocketServer::Stats SocketServer::getStats(const bool withConnections) const
+{
+    if (impl_)
+        return impl_->getStats(withConnections);
+    return {};
+}
+
+void SocketServer::stop(const int timeoutMs)
+{
+    if (impl_)
+        impl_->stop(timeoutMs);
 }
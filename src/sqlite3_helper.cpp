@@ -8,7 +8,16 @@
 */
 
 #include <map>
+#include <list>
 #include <mutex>
+#include <atomic>
+#include <thread>
+#include <future>
+#include <condition_variable>
+#include <cctype>
+#include <algorithm>
+#include <string_view>
+#include <unordered_map>
 #include "include/jade_tools.h"
 #if defined(__has_include)
 #  if __has_include(<sqlite3.h>)  // 标准化的头文件存在性检查
@@ -20,20 +29,291 @@
 
 using namespace jade;
 
+namespace
+{
+    constexpr size_t kDefaultStatementCacheSize = 64;
+
+    // 判断SQL是否为修改表结构的语句(以CREATE/DROP/ALTER开头,跳过前面的空白和注释),这类语句通常只执行一次,不缓存。
+    // 表结构变化后已缓存的语句由sqlite3_prepare_v2在执行时自动重新编译
+    bool isSchemaStatement(const std::string& sql)
+    {
+        size_t i = 0;
+        while (i < sql.size())
+        {
+            if (std::isspace(static_cast<unsigned char>(sql[i])))
+            {
+                ++i;
+            }
+            else if (sql.compare(i, 2, "--") == 0)
+            {
+                i = sql.find('\n', i);
+            }
+            else if (sql.compare(i, 2, "/*") == 0)
+            {
+                i = sql.find("*/", i + 2);
+                i = i == std::string::npos ? i : i + 2;
+            }
+            else
+            {
+                break;
+            }
+        }
+        if (i >= sql.size())
+            return false;
+        const size_t begin = i;
+        while (i < sql.size() && std::isalpha(static_cast<unsigned char>(sql[i])))
+            ++i;
+        std::string word(sql, begin, i - begin);
+        for (auto& c : word)
+            c = static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
+        return word == "CREATE" || word == "DROP" || word == "ALTER";
+    }
+
+#ifdef SQLITE3_ENABLE
+    // 预编译语句LRU缓存,按SQL文本索引,由所属连接的互斥锁保护
+    class StatementCache
+    {
+    public:
+        explicit StatementCache(const size_t capacity): capacity_(capacity)
+        {
+        }
+
+        ~StatementCache()
+        {
+            clear();
+        }
+
+        StatementCache(const StatementCache&) = delete;
+        StatementCache& operator=(const StatementCache&) = delete;
+
+        struct Entry
+        {
+            std::string sql;
+            sqlite3_stmt* stmt;
+            size_t rowEstimate; // 上一次查询返回的行数,用于预分配结果
+            bool busy; // 正在被StatementHandle使用,嵌套查询同一SQL时不能复用
+        };
+
+        // 命中时返回缓存的语句并移到队首,未命中返回nullptr
+        Entry* find(const std::string& sql)
+        {
+            const auto it = index_.find(sql);
+            if (it == index_.end())
+            {
+                ++misses_;
+                return nullptr;
+            }
+            ++hits_;
+            lru_.splice(lru_.begin(), lru_, it->second);
+            return &*it->second;
+        }
+
+        // 加入缓存,超出容量时淘汰最久未使用的语句;容量为0时返回nullptr,由调用方自行finalize
+        Entry* insert(const std::string& sql, sqlite3_stmt* stmt)
+        {
+            if (capacity_ == 0)
+                return nullptr;
+            lru_.push_front({sql, stmt, 0, false});
+            index_.emplace(lru_.front().sql, lru_.begin());
+            evict(capacity_);
+            return &lru_.front();
+        }
+
+        // 移出缓存但不finalize,语句由持有它的StatementHandle在析构时finalize
+        void detach(const Entry* entry)
+        {
+            const auto it = index_.find(entry->sql);
+            if (it == index_.end() || &*it->second != entry)
+                return;
+            const auto position = it->second;
+            index_.erase(it);
+            lru_.erase(position);
+        }
+
+        void clear()
+        {
+            evict(0);
+        }
+
+        void setCapacity(const size_t capacity)
+        {
+            capacity_ = capacity;
+            evict(capacity_);
+        }
+
+        [[nodiscard]] uint64_t hits() const { return hits_; }
+        [[nodiscard]] uint64_t misses() const { return misses_; }
+        [[nodiscard]] size_t size() const { return lru_.size(); }
+        [[nodiscard]] size_t capacity() const { return capacity_; }
+
+    private:
+        // 从最久未使用的语句开始淘汰,跳过正在使用的语句
+        void evict(const size_t capacity)
+        {
+            auto it = lru_.end();
+            while (lru_.size() > capacity && it != lru_.begin())
+            {
+                --it;
+                if (it->busy)
+                    continue;
+                index_.erase(it->sql);
+                sqlite3_finalize(it->stmt);
+                it = lru_.erase(it);
+            }
+        }
+
+        size_t capacity_;
+        uint64_t hits_ = 0;
+        uint64_t misses_ = 0;
+        std::list<Entry> lru_;
+        std::unordered_map<std::string_view, std::list<Entry>::iterator> index_; // 键指向lru_中的sql
+    };
+
+    // 作用域内持有一条语句,析构时缓存的语句reset并清除绑定(释放读事务),未缓存的语句直接finalize
+    class StatementHandle
+    {
+    public:
+        StatementHandle(sqlite3_stmt* stmt, StatementCache::Entry* entry): stmt_(stmt), entry_(entry)
+        {
+            if (entry_)
+                entry_->busy = true;
+        }
+
+        ~StatementHandle()
+        {
+            if (!stmt_)
+                return;
+            if (entry_)
+            {
+                entry_->busy = false;
+                sqlite3_reset(stmt_);
+                sqlite3_clear_bindings(stmt_);
+            }
+            else
+            {
+                sqlite3_finalize(stmt_);
+            }
+        }
+
+        StatementHandle(const StatementHandle&) = delete;
+        StatementHandle& operator=(const StatementHandle&) = delete;
+
+        [[nodiscard]] sqlite3_stmt* get() const { return stmt_; }
+        // 语句执行出错时移出缓存,下次重新编译;语句在句柄析构时finalize,使用期间保持有效
+        void evict(StatementCache& cache)
+        {
+            if (entry_)
+            {
+                entry_->busy = false;
+                cache.detach(entry_);
+                entry_ = nullptr;
+            }
+        }
+        // 缓存的语句返回上一次查询的行数,未缓存返回nullptr
+        [[nodiscard]] size_t* rowEstimate() const { return entry_ ? &entry_->rowEstimate : nullptr; }
+        explicit operator bool() const { return stmt_ != nullptr; }
+
+    private:
+        sqlite3_stmt* stmt_;
+        StatementCache::Entry* entry_;
+    };
+#endif
+
+    // 多生产者单消费者无锁队列(Vyukov): 入队只需一次原子交换,出队只由后台写线程执行,
+    // 节点需包含 std::atomic<T*> next 成员
+    template <typename T>
+    class MpscQueue
+    {
+    public:
+        MpscQueue(): head_(&stub_), tail_(&stub_)
+        {
+        }
+
+        MpscQueue(const MpscQueue&) = delete;
+        MpscQueue& operator=(const MpscQueue&) = delete;
+
+        void push(T* node)
+        {
+            node->next.store(nullptr, std::memory_order_relaxed);
+            T* prev = head_.exchange(node, std::memory_order_acq_rel);
+            prev->next.store(node, std::memory_order_release);
+        }
+
+        // 队列为空或有生产者尚未完成入队时返回nullptr
+        T* pop()
+        {
+            T* tail = tail_;
+            T* next = tail->next.load(std::memory_order_acquire);
+            if (tail == &stub_)
+            {
+                if (!next)
+                    return nullptr;
+                tail_ = next;
+                tail = next;
+                next = next->next.load(std::memory_order_acquire);
+            }
+            if (next)
+            {
+                tail_ = next;
+                return tail;
+            }
+            if (tail != head_.load(std::memory_order_acquire))
+                return nullptr;
+            push(&stub_);
+            next = tail->next.load(std::memory_order_acquire);
+            if (next)
+            {
+                tail_ = next;
+                return tail;
+            }
+            return nullptr;
+        }
+
+    private:
+        T stub_;
+        std::atomic<T*> head_;
+        T* tail_;
+    };
+}
+
 class SqliteHelper::Impl
 {
 public:
-    explicit Impl(const char* dbPath)
+    Impl(const char* dbPath, const TuningProfile& profile, int readerCount)
     {
 #ifdef SQLITE3_ENABLE
-        db_ = nullptr;
-        if (sqlite3_open(dbPath, &db_) != SQLITE_OK)
+        writer_ = openConnection(dbPath, SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE);
+        // page_size需要在切换到WAL之前设置,之后对已有数据库不再生效
+        execute("PRAGMA page_size=" + std::to_string(profile.pageSize) + ";");
+        // 启用WAL模式（提高并发性能）, 读连接与写连接互不阻塞
+        execute("PRAGMA journal_mode=WAL;");
+        applyProfile(*writer_, profile);
+        const std::string walPragmas = "PRAGMA wal_autocheckpoint=" + std::to_string(profile.walAutoCheckpoint) +
+            ";PRAGMA journal_size_limit=" + std::to_string(profile.journalSizeLimit) + ";";
+        execute(walPragmas);
+        // 内存数据库无法在多个连接之间共享,只使用写连接
+        const std::string path = dbPath ? dbPath : "";
+        const bool inMemory = path.empty() || path == ":memory:" || path.rfind("file::memory:", 0) == 0;
+        if (inMemory)
         {
-            DLL_LOG_ERROR(MODULE_NAME) << "Failed to open database";
-            throw std::runtime_error("Failed to open database");
+            readerCount = 0;
         }
-        // 启用WAL模式（提高并发性能）
-        execute("PRAGMA journal_mode=WAL;");
+        for (int i = 0; i < readerCount; ++i)
+        {
+            readers_.push_back(openConnection(dbPath, SQLITE_OPEN_READONLY));
+            applyProfile(*readers_.back(), profile);
+        }
+        if (!inMemory && profile.checkpointIntervalMs > 0)
+        {
+            // checkpoint使用独立的连接,PASSIVE模式不阻塞写连接
+            checkpointer_ = openConnection(dbPath, SQLITE_OPEN_READWRITE);
+            applyProfile(*checkpointer_, profile);
+            checkpoint_thread_ = std::thread(&Impl::checkpointLoop, this,
+                                             std::chrono::milliseconds(profile.checkpointIntervalMs));
+        }
+        DLL_LOG_TRACE(MODULE_NAME) << "打开sqlite3完成,只读连接数:" << static_cast<int>(readers_.size())
+            << ",synchronous:" << static_cast<int>(profile.synchronous) << ",后台checkpoint间隔:"
+            << profile.checkpointIntervalMs << "ms";
 #endif
     };
 
@@ -41,29 +321,40 @@ public:
     {
         DLL_LOG_TRACE(MODULE_NAME) << "准备关闭sqlite3 ...";
 #ifdef SQLITE3_ENABLE
-        if (db_)
+        stopAsyncWriter();
+        stopCheckpointer();
+        // 停止后才入队的请求不再执行
+        while (WriteRequest* request = write_queue_.pop())
+        {
+            complete(request, false);
+        }
+        for (const auto& reader : readers_)
+        {
+            std::lock_guard lock(reader->mutex);
+        }
+        readers_.clear();
+        if (writer_)
         {
-            std::lock_guard lock(db_mutex_);
-            // 如果还有未提交的事务，回滚
-            if (transaction_count_ > 0)
+            // 当前线程还有未提交的事务时回滚并释放写连接,其他线程的事务等待其结束
+            if (transaction_owner_ == std::this_thread::get_id())
             {
-                sqlite3_exec(db_, "ROLLBACK;", nullptr, nullptr, nullptr);
-            }
-            if (sqlite3_close(db_) != SQLITE_OK) {
-                DLL_LOG_ERROR(MODULE_NAME) << "SQLite关闭错误: " << sqlite3_errmsg(db_);
+                sqlite3_exec(writer_->db, "ROLLBACK;", nullptr, nullptr, nullptr);
+                endTransaction();
             }
-            db_ = nullptr;
+            std::lock_guard lock(writer_->mutex);
         }
+        writer_.reset();
         DLL_LOG_TRACE(MODULE_NAME) << "关闭sqlite3完成";
 #endif
     }
 
     bool execute(const std::string& sql)
     {
-        std::lock_guard lock(db_mutex_);
 #ifdef SQLITE3_ENABLE
+        const WriterLock lock(*this);
         char* errMsg = nullptr;
-        if (sqlite3_exec(db_, sql.c_str(), nullptr, nullptr, &errMsg) != SQLITE_OK)
+        const int result = sqlite3_exec(writer_->db, sql.c_str(), nullptr, nullptr, &errMsg);
+        if (result != SQLITE_OK)
         {
             DLL_LOG_WARN(MODULE_NAME) << "SQL WARN: " << errMsg;
             sqlite3_free(errMsg);
@@ -73,161 +364,359 @@ public:
         return true;
     }
 
-    std::vector<std::map<std::string, SQLiteValue>> query(const std::string& sql)
+    template <typename Params>
+    std::vector<std::map<std::string, SQLiteValue>> query(const std::string& sql, const Params& params)
     {
-#ifdef SQLITE3_ENABLE
-        std::lock_guard lock(db_mutex_);
         std::vector<std::map<std::string, SQLiteValue>> results;
-        sqlite3_stmt* stmt = nullptr;
+#ifdef SQLITE3_ENABLE
+        runQuery(sql, [&](const StatementHandle& handle)
+        {
+            if (!bindParams(handle.get(), params))
+            {
+                throw std::runtime_error("Failed to bind parameters");
+            }
+            results = readRows(handle.get());
+        });
+#endif
+        return results;
+    }
 
-        if (sqlite3_prepare_v2(db_, sql.c_str(), -1, &stmt, nullptr) != SQLITE_OK)
+    // 逐行回调,结果集不落地,回调期间持有连接锁;reserve用于按上一次的行数预分配结果
+    template <typename Params>
+    size_t queryEach(const std::string& sql, const Params& params, const RowVisitor& visitor,
+                     const std::function<void(size_t)>& reserve)
+    {
+        size_t count = 0;
+#ifdef SQLITE3_ENABLE
+        runQuery(sql, [&](const StatementHandle& handle)
         {
+            sqlite3_stmt* stmt = handle.get();
+            size_t* rowEstimate = handle.rowEstimate();
+            if (reserve && rowEstimate && *rowEstimate > 0)
+            {
+                reserve(*rowEstimate);
+            }
+            if (!bindParams(stmt, params))
+            {
+                throw std::runtime_error("Failed to bind parameters");
+            }
+            const Row row(stmt);
+            int result;
+            while ((result = sqlite3_step(stmt)) == SQLITE_ROW)
+            {
+                ++count;
+                if (!visitor(row))
+                    return;
+            }
+            if (result != SQLITE_DONE)
+            {
+                DLL_LOG_WARN(MODULE_NAME) << "SQL WARN: " << sqlite3_errmsg(sqlite3_db_handle(stmt));
+            }
+            else if (rowEstimate)
+            {
+                *rowEstimate = count;
+            }
+        });
+#endif
+        return count;
+    }
 
-            DLL_LOG_ERROR(MODULE_NAME) << "Failed to prepare statement";
-            throw std::runtime_error("Failed to prepare statement");
+    template <typename Params>
+    bool executeWithParams(const std::string& sql, const Params& params)
+    {
+#ifdef SQLITE3_ENABLE
+        const WriterLock lock(*this);
+        return stepWithParams(*writer_, sql, params);
+#else
+        return false;
+#endif
+    }
+
+    // 语句只编译一次,在一个事务中逐行绑定执行,单行失败不影响其他行,提交失败时全部回滚
+    BatchResult executeBatch(const std::string& sql, const std::vector<std::vector<SQLiteValue>>& rows)
+    {
+        BatchResult result;
+#ifdef SQLITE3_ENABLE
+        const WriterLock lock(*this);
+        const StatementHandle handle = prepare(*writer_, sql);
+        if (!handle)
+        {
+            for (size_t i = 0; i < rows.size(); ++i)
+                result.failedRows.push_back(i);
+            return result;
         }
-        const int colCount = sqlite3_column_count(stmt);
-        while (sqlite3_step(stmt) == SQLITE_ROW)
+        sqlite3_stmt* stmt = handle.get();
+        // 使用SAVEPOINT,外部已有事务时作为其中的一部分
+        if (sqlite3_exec(writer_->db, "SAVEPOINT execute_batch;", nullptr, nullptr, nullptr) != SQLITE_OK)
         {
-            std::map<std::string, SQLiteValue> row;
-            for (int i = 0; i < colCount; ++i)
+            DLL_LOG_ERROR(MODULE_NAME) << "批量写入开始事务失败: " << sqlite3_errmsg(writer_->db);
+            for (size_t i = 0; i < rows.size(); ++i)
+                result.failedRows.push_back(i);
+            return result;
+        }
+        for (size_t i = 0; i < rows.size(); ++i)
+        {
+            sqlite3_reset(stmt);
+            sqlite3_clear_bindings(stmt);
+            if (bindParams(stmt, rows[i]) && sqlite3_step(stmt) == SQLITE_DONE)
             {
-                const char* columnName = sqlite3_column_name(stmt, i);
-                switch (sqlite3_column_type(stmt, i))
-                {
-                case SQLITE_NULL:
-                    row[columnName] = nullptr;
-                    break;
-                case SQLITE_INTEGER:
-                    row[columnName] = sqlite3_column_int64(stmt, i);
-                    break;
-                case SQLITE_FLOAT:
-                    row[columnName] = sqlite3_column_double(stmt, i);
-                    break;
-                case SQLITE_TEXT:
-                    row[columnName] = reinterpret_cast<const char*>(sqlite3_column_text(stmt, i));
-                    break;
-                case SQLITE_BLOB:
-                {
-                    const void* blob = sqlite3_column_blob(stmt, i);
-                    const int size = sqlite3_column_bytes(stmt, i);
-                    const auto data = static_cast<const uint8_t*>(blob);
-                    row[columnName] = std::vector<uint8_t>(data, data + size);
-                    break;
-                }
-                default:
-                    DLL_LOG_ERROR(MODULE_NAME) << "Unsupported SQLite data type: " << columnName;
-                    throw std::runtime_error("Unsupported SQLite data type");
-                }
+                ++result.succeeded;
+            }
+            else
+            {
+                DLL_LOG_WARN(MODULE_NAME) << "批量写入第" << static_cast<int>(i) << "行失败: "
+                    << sqlite3_errmsg(writer_->db);
+                result.failedRows.push_back(i);
             }
-            results.emplace_back(row);
         }
-        sqlite3_finalize(stmt);
-        return results;
+        sqlite3_reset(stmt);
+        result.committed = sqlite3_exec(writer_->db, "RELEASE execute_batch;", nullptr, nullptr, nullptr) ==
+            SQLITE_OK;
+        if (!result.committed)
+        {
+            DLL_LOG_ERROR(MODULE_NAME) << "批量写入提交失败: " << sqlite3_errmsg(writer_->db);
+            sqlite3_exec(writer_->db, "ROLLBACK TO execute_batch; RELEASE execute_batch;", nullptr, nullptr, nullptr);
+            result.succeeded = 0;
+            result.failedRows.clear();
+            for (size_t i = 0; i < rows.size(); ++i)
+                result.failedRows.push_back(i);
+        }
 #else
-        return {}
+        for (size_t i = 0; i < rows.size(); ++i)
+            result.failedRows.push_back(i);
 #endif
+        return result;
     }
 
-    bool executeWithParams(const std::string& sql, const std::vector<SQLiteValue>& params)
+    void startAsyncWriter(const AsyncWriteOptions& options)
     {
 #ifdef SQLITE3_ENABLE
-        std::lock_guard lock(db_mutex_);
-        sqlite3_stmt* stmt = nullptr;
+        std::lock_guard lock(write_start_mutex_);
+        write_stopped_ = false;
+        if (write_running_)
+            return;
+        startAsyncWriterLocked(options);
+#endif
+    }
 
-        if (sqlite3_prepare_v2(db_, sql.c_str(), -1, &stmt, nullptr) != SQLITE_OK)
-        {
+#ifdef SQLITE3_ENABLE
+    // 调用方需持有write_start_mutex_
+    void startAsyncWriterLocked(const AsyncWriteOptions& options)
+    {
+        write_options_ = options;
+        write_options_.maxBatchSize = std::max<size_t>(1, options.maxBatchSize);
+        write_batch_size_ = write_options_.maxBatchSize;
+        write_running_ = true;
+        write_thread_ = std::thread(&Impl::writeLoop, this);
+        DLL_LOG_TRACE(MODULE_NAME) << "异步写线程已启动,批量大小:" << static_cast<int>(write_options_.maxBatchSize)
+            << ",时间窗口:" << write_options_.maxDelayMs << "ms";
+    }
+
+    // 首次executeAsync时以默认配置启动写线程;调用过stopAsyncWriter后不再自动启动,返回false
+    bool ensureAsyncWriter()
+    {
+        std::lock_guard lock(write_start_mutex_);
+        if (write_running_)
+            return true;
+        if (write_stopped_)
             return false;
-        }
+        startAsyncWriterLocked(AsyncWriteOptions());
+        return true;
+    }
+#endif
 
-        for (size_t i = 0; i < params.size(); ++i)
+#ifdef SQLITE3_ENABLE
+    // 写线程已退出后仍留在队列中的请求回报失败;等待正在进行的stopAsyncWriter结束,
+    // 期间写线程被重新启动时由它继续执行
+    void failStrandedWrites()
+    {
+        std::lock_guard lock(write_start_mutex_);
+        while (!write_running_ && write_pending_ > 0)
         {
-            std::visit([&](auto&& arg)
+            if (WriteRequest* request = write_queue_.pop())
             {
-                using T = std::decay_t<decltype(arg)>;
-                if constexpr (std::is_same_v<T, std::monostate>)
-                {
-                    sqlite3_bind_null(stmt, static_cast<int>(i) + 1);
-                }
-                else if constexpr (std::is_same_v<T, int64_t>)
-                {
-                    sqlite3_bind_int64(stmt, i + 1, arg);
-                }
-                else if constexpr (std::is_same_v<T, double>)
-                {
-                    sqlite3_bind_double(stmt, i + 1, arg);
-                }
-                else if constexpr (std::is_same_v<T, std::string>)
-                {
-                    sqlite3_bind_text(stmt, i + 1, arg.c_str(), -1, SQLITE_TRANSIENT);
-                }
-                else if constexpr (std::is_same_v<T, std::vector<uint8_t>>)
-                {
-                    sqlite3_bind_blob(stmt, i + 1, arg.data(), arg.size(), SQLITE_TRANSIENT);
-                }
-            }, params[i]);
+                write_pending_ -= 1;
+                DLL_LOG_WARN(MODULE_NAME) << "异步写线程已停止,写入失败: " << request->sql;
+                complete(request, false);
+            }
+            else
+            {
+                std::this_thread::yield(); // 生产者正在入队
+            }
         }
+    }
+#endif
 
-        const int result = sqlite3_step(stmt);
-        sqlite3_finalize(stmt);
-        return (result == SQLITE_DONE);
+    // 停止异步写线程,返回前执行完队列中已有的请求
+    void stopAsyncWriter()
+    {
+#ifdef SQLITE3_ENABLE
+        std::lock_guard lock(write_start_mutex_);
+        write_stopped_ = true;
+        if (!write_running_)
+            return;
+        {
+            std::lock_guard writeLock(write_mutex_);
+            write_running_ = false;
+        }
+        write_condition_.notify_all();
+        if (write_thread_.joinable())
+        {
+            write_thread_.join();
+        }
+#endif
+    }
+
+    void executeAsync(const std::string& sql, std::vector<SQLiteValue> params, std::promise<bool>* promise,
+                      WriteCallback callback)
+    {
+#ifdef SQLITE3_ENABLE
+        auto* request = new WriteRequest();
+        request->sql = sql;
+        request->params = std::move(params);
+        request->callback = std::move(callback);
+        if (promise)
+        {
+            request->promise = std::move(*promise);
+            request->hasPromise = true;
+        }
+        if (!write_running_ && !ensureAsyncWriter())
+        {
+            DLL_LOG_WARN(MODULE_NAME) << "异步写线程已停止,写入失败: " << sql;
+            complete(request, false);
+            return;
+        }
+        write_queue_.push(request);
+        // 只在队列由空变为非空或攒满一批时唤醒写线程,其余入队不加锁
+        const size_t pending = write_pending_.fetch_add(1, std::memory_order_acq_rel) + 1;
+        if (pending == 1 || pending == write_batch_size_.load(std::memory_order_relaxed))
+        {
+            std::lock_guard lock(write_mutex_);
+            write_condition_.notify_one();
+        }
+        // 入队前写线程还在运行,入队时已被stopAsyncWriter停止: 写线程退出前没有取到的请求在这里回报失败
+        if (!write_running_)
+        {
+            failStrandedWrites();
+        }
 #else
-        return false;
+        if (promise)
+            promise->set_value(false);
+        if (callback)
+            callback(false);
 #endif
     }
 
-    // 添加事务管理方法
+    // 事务属于开启它的线程,最外层事务在整个生命周期内独占写连接,其他线程的写操作等待其结束;
+    // 同一线程内嵌套的事务使用SAVEPOINT,可以单独提交或回滚
     void beginTransaction()
     {
-        std::lock_guard lock(trans_mutex_);
-        if (transaction_count_ == 0)
-        {
 #ifdef SQLITE3_ENABLE
-            if (!execute("BEGIN TRANSACTION;"))
+        if (transaction_owner_ == std::this_thread::get_id())
+        {
+            const std::string savepoint = "SAVEPOINT transaction_" + std::to_string(transaction_depth_) + ";";
+            if (!execute(savepoint))
             {
-                DLL_LOG_ERROR(MODULE_NAME) << "Failed to begin transaction";
-                throw std::runtime_error("Failed to begin transaction");
+                DLL_LOG_ERROR(MODULE_NAME) << "Failed to begin nested transaction";
+                throw std::runtime_error("Failed to begin nested transaction");
             }
-#endif
+            ++transaction_depth_;
+            return;
+        }
+        writer_->mutex.lock();
+        transaction_owner_ = std::this_thread::get_id();
+        transaction_depth_ = 1;
+        // IMMEDIATE在开始时就获取数据库写锁,避免其他进程写入时在事务中途升级失败
+        if (!execute("BEGIN IMMEDIATE;"))
+        {
+            endTransaction();
+            DLL_LOG_ERROR(MODULE_NAME) << "Failed to begin transaction";
+            throw std::runtime_error("Failed to begin transaction");
         }
-        transaction_count_++;
+#endif
     }
 
     void commitTransaction()
     {
-        std::lock_guard lock(trans_mutex_);
-        if (transaction_count_ <= 0)
+#ifdef SQLITE3_ENABLE
+        if (transaction_owner_ != std::this_thread::get_id())
         {
             DLL_LOG_ERROR(MODULE_NAME) << "No active transaction to commit";
             throw std::runtime_error("No active transaction to commit");
         }
-
-        transaction_count_--;
-        if (transaction_count_ == 0)
+        if (transaction_depth_ > 1)
         {
-            if (!execute("COMMIT;"))
+            if (!execute("RELEASE transaction_" + std::to_string(transaction_depth_ - 1) + ";"))
             {
-                DLL_LOG_ERROR(MODULE_NAME) << "Failed to commit transaction";
-                throw std::runtime_error("Failed to commit transaction");
+                DLL_LOG_ERROR(MODULE_NAME) << "Failed to release nested transaction";
+                throw std::runtime_error("Failed to release nested transaction");
             }
+            --transaction_depth_;
+            return;
+        }
+        // 提交失败时事务保持打开,由Transaction析构时回滚
+        if (!execute("COMMIT;"))
+        {
+            DLL_LOG_ERROR(MODULE_NAME) << "Failed to commit transaction";
+            throw std::runtime_error("Failed to commit transaction");
         }
+        endTransaction();
+#endif
     }
 
     void rollbackTransaction()
     {
-        std::lock_guard lock(trans_mutex_);
-        if (transaction_count_ <= 0)
+#ifdef SQLITE3_ENABLE
+        if (transaction_owner_ != std::this_thread::get_id())
         {
             DLL_LOG_ERROR(MODULE_NAME) << "No active transaction to rollback";
             throw std::runtime_error("No active transaction to rollback");
         }
-
-        transaction_count_ = 0; // 重置计数器
-        if (!execute("ROLLBACK;"))
+        if (transaction_depth_ > 1)
+        {
+            const std::string savepoint = "transaction_" + std::to_string(transaction_depth_ - 1);
+            --transaction_depth_;
+            if (!execute("ROLLBACK TO " + savepoint + ";RELEASE " + savepoint + ";"))
+            {
+                DLL_LOG_ERROR(MODULE_NAME) << "Failed to rollback nested transaction";
+                throw std::runtime_error("Failed to rollback nested transaction");
+            }
+            return;
+        }
+        // 无论回滚是否成功都释放写连接
+        const bool rolledBack = execute("ROLLBACK;");
+        endTransaction();
+        if (!rolledBack)
         {
             DLL_LOG_ERROR(MODULE_NAME) << "Failed to rollback transaction";
             throw std::runtime_error("Failed to rollback transaction");
         }
+#endif
+    }
+
+    [[nodiscard]] StatementCacheStats getStatementCacheStats()
+    {
+        StatementCacheStats stats;
+#ifdef SQLITE3_ENABLE
+        forEachConnection([&stats](const Connection& connection)
+        {
+            stats.hits += connection.statements.hits();
+            stats.misses += connection.statements.misses();
+            stats.size += connection.statements.size();
+            stats.capacity = connection.statements.capacity();
+        });
+#endif
+        return stats;
+    }
+
+    void setStatementCacheSize(const size_t capacity)
+    {
+#ifdef SQLITE3_ENABLE
+        forEachConnection([capacity](Connection& connection)
+        {
+            connection.statements.setCapacity(capacity);
+        });
+#endif
     }
 
     // 禁止复制
@@ -236,27 +725,632 @@ public:
 
 private:
 #ifdef SQLITE3_ENABLE
-    sqlite3* db_;
-#endif
-    std::mutex db_mutex_;
-    std::mutex trans_mutex_; // 事务互斥锁
-    int transaction_count_ = 0; // 事务嵌套计数器
-};
+    // 数据库连接及其语句缓存,由mutex保护,同一时刻只被一个线程使用
+    struct Connection
+    {
+        sqlite3* db = nullptr;
+        std::mutex mutex;
+        StatementCache statements{kDefaultStatementCacheSize};
 
-SqliteHelper& SqliteHelper::getInstance()
-{
-    static SqliteHelper instance;
-    return instance;
-}
+        ~Connection()
+        {
+            // 关闭前必须finalize所有缓存的语句
+            statements.clear();
+            if (db && sqlite3_close(db) != SQLITE_OK)
+            {
+                DLL_LOG_ERROR(MODULE_NAME) << "SQLite关闭错误: " << sqlite3_errmsg(db);
+            }
+        }
+    };
 
-bool SqliteHelper::execute(const std::string& sql) const
-{
-    return impl_->execute(sql);
+    // 连接锁,同时登记当前线程持有的连接: 查询的visitor中再次访问数据库时,
+    // 已持有的连接直接复用而不是再次加锁(std::mutex不可重入)
+    class ConnectionLock
+    {
+    public:
+        ConnectionLock() = default;
+        ConnectionLock(const ConnectionLock&) = delete;
+        ConnectionLock& operator=(const ConnectionLock&) = delete;
+
+        ~ConnectionLock()
+        {
+            if (lock_.owns_lock())
+            {
+                auto& connections = held();
+                connections.erase(std::find(connections.begin(), connections.end(), lock_.mutex()));
+            }
+        }
+
+        void lock(Connection& connection)
+        {
+            lock_ = std::unique_lock(connection.mutex);
+            held().push_back(&connection.mutex);
+        }
+
+        bool tryLock(Connection& connection)
+        {
+            lock_ = std::unique_lock(connection.mutex, std::try_to_lock);
+            if (lock_.owns_lock())
+                held().push_back(&connection.mutex);
+            return lock_.owns_lock();
+        }
+
+        static bool heldByCurrentThread(const Connection& connection)
+        {
+            const auto& connections = held();
+            return std::find(connections.begin(), connections.end(), &connection.mutex) != connections.end();
+        }
+
+    private:
+        std::unique_lock<std::mutex> lock_;
+
+        static std::vector<const std::mutex*>& held()
+        {
+            thread_local std::vector<const std::mutex*> connections;
+            return connections;
+        }
+    };
+
+    std::unique_ptr<Connection> writer_; // 所有写操作和事务都在写连接上执行
+    std::vector<std::unique_ptr<Connection>> readers_; // 只读连接,WAL模式下可与写连接并发读取
+    std::atomic<size_t> next_reader_{0};
+
+    static std::unique_ptr<Connection> openConnection(const char* dbPath, const int flags)
+    {
+        auto connection = std::make_unique<Connection>();
+        // 每个连接由自身的互斥锁保护,关闭sqlite内部的连接级互斥锁
+        if (sqlite3_open_v2(dbPath, &connection->db, flags | SQLITE_OPEN_NOMUTEX, nullptr) != SQLITE_OK)
+        {
+            DLL_LOG_ERROR(MODULE_NAME) << "Failed to open database: " << sqlite3_errmsg(connection->db);
+            throw std::runtime_error("Failed to open database");
+        }
+        return connection;
+    }
+
+    // 选择一个空闲的只读连接,全部繁忙时按轮询排队等待;没有只读连接时使用写连接。
+    // 当前线程持有事务时使用写连接,以读到事务内未提交的数据,其他线程的读不受影响。
+    // 当前线程已持有的连接(在查询的visitor中再次查询)不再加锁: 只读连接跳过它们,没有其他连接可用时直接复用
+    Connection& acquireReader(ConnectionLock& lock)
+    {
+        if (transaction_owner_ == std::this_thread::get_id())
+        {
+            return *writer_;
+        }
+        if (readers_.empty())
+        {
+            if (!ConnectionLock::heldByCurrentThread(*writer_))
+                lock.lock(*writer_);
+            return *writer_;
+        }
+        const size_t start = next_reader_.fetch_add(1, std::memory_order_relaxed);
+        Connection* waitFor = nullptr;
+        for (size_t i = 0; i < readers_.size(); ++i)
+        {
+            Connection& reader = *readers_[(start + i) % readers_.size()];
+            if (ConnectionLock::heldByCurrentThread(reader))
+                continue;
+            if (lock.tryLock(reader))
+                return reader;
+            if (!waitFor)
+                waitFor = &reader;
+        }
+        if (!waitFor)
+        {
+            return *readers_[start % readers_.size()];
+        }
+        lock.lock(*waitFor);
+        return *waitFor;
+    }
+
+    template <typename Func>
+    void forEachConnection(Func&& func)
+    {
+        {
+            const WriterLock lock(*this);
+            func(*writer_);
+        }
+        for (const auto& reader : readers_)
+        {
+            ConnectionLock lock;
+            if (!ConnectionLock::heldByCurrentThread(*reader))
+                lock.lock(*reader);
+            func(*reader);
+        }
+    }
+
+    // 从连接的缓存中取出语句,未命中时编译并加入缓存,调用方需持有connection.mutex
+    StatementHandle prepare(Connection& connection, const std::string& sql)
+    {
+        StatementCache::Entry* cached = connection.statements.find(sql);
+        if (cached && !cached->busy)
+        {
+            return {cached->stmt, cached};
+        }
+        sqlite3_stmt* stmt = nullptr;
+        if (sqlite3_prepare_v2(connection.db, sql.c_str(), -1, &stmt, nullptr) != SQLITE_OK)
+        {
+            DLL_LOG_WARN(MODULE_NAME) << "SQL WARN: " << sqlite3_errmsg(connection.db);
+            sqlite3_finalize(stmt);
+            return {nullptr, nullptr};
+        }
+        // 同一SQL的缓存语句正在被外层查询使用时,本次使用独立的语句,用完即finalize
+        if (cached || isSchemaStatement(sql))
+        {
+            return {stmt, nullptr};
+        }
+        return {stmt, connection.statements.insert(sql, stmt)};
+    }
+
+    // 绑定单个参数。参数在语句执行期间由调用方持有,执行后语句会reset并清除绑定,
+    // 因此TEXT/BLOB使用SQLITE_STATIC,不再拷贝一份
+    static int bindValue(sqlite3_stmt* stmt, const int index, const SQLiteValue& value)
+    {
+        if (const auto* integer = std::get_if<SqliteInt64>(&value))
+            return sqlite3_bind_int64(stmt, index, *integer);
+        if (const auto* real = std::get_if<double>(&value))
+            return sqlite3_bind_double(stmt, index, *real);
+        if (const auto* text = std::get_if<std::string>(&value))
+            return sqlite3_bind_text(stmt, index, text->data(), static_cast<int>(text->size()), SQLITE_STATIC);
+        if (const auto* blob = std::get_if<std::vector<uint8_t>>(&value))
+        {
+            // 空BLOB的data()可能为nullptr,sqlite会将其绑定为NULL
+            static constexpr uint8_t kEmpty = 0;
+            return sqlite3_bind_blob(stmt, index, blob->empty() ? &kEmpty : blob->data(),
+                                     static_cast<int>(blob->size()), SQLITE_STATIC);
+        }
+        return sqlite3_bind_null(stmt, index);
+    }
+
+    // 按位置绑定参数,下标从1开始
+    static bool bindParams(sqlite3_stmt* stmt, const std::vector<SQLiteValue>& params)
+    {
+        for (size_t i = 0; i < params.size(); ++i)
+        {
+            if (bindValue(stmt, static_cast<int>(i) + 1, params[i]) != SQLITE_OK)
+            {
+                DLL_LOG_WARN(MODULE_NAME) << "绑定第" << static_cast<int>(i + 1) << "个参数失败: "
+                    << sqlite3_errmsg(sqlite3_db_handle(stmt));
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // 按名称绑定参数,名称可以省略 :/@/$ 前缀
+    static bool bindParams(sqlite3_stmt* stmt, const NamedParams& params)
+    {
+        for (const auto& [name, value] : params.values)
+        {
+            int index = sqlite3_bind_parameter_index(stmt, name.c_str());
+            if (index == 0 && !name.empty() && name[0] != ':' && name[0] != '@' && name[0] != '$')
+            {
+                for (const char prefix : {':', '@', '$'})
+                {
+                    if ((index = sqlite3_bind_parameter_index(stmt, (prefix + name).c_str())) != 0)
+                        break;
+                }
+            }
+            if (index == 0 || bindValue(stmt, index, value) != SQLITE_OK)
+            {
+                DLL_LOG_WARN(MODULE_NAME) << "绑定参数失败: " << name;
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // 绑定参数并执行一条写语句,调用方需持有connection.mutex
+    template <typename Params>
+    bool stepWithParams(Connection& connection, const std::string& sql, const Params& params)
+    {
+        StatementHandle handle = prepare(connection, sql);
+        if (!handle)
+        {
+            return false;
+        }
+        sqlite3_stmt* stmt = handle.get();
+
+        if (!bindParams(stmt, params))
+        {
+            return false;
+        }
+        const int result = sqlite3_step(stmt);
+        if (result != SQLITE_DONE)
+        {
+            DLL_LOG_WARN(MODULE_NAME) << "SQL WARN: " << sqlite3_errmsg(connection.db);
+            handle.evict(connection.statements);
+        }
+        return (result == SQLITE_DONE);
+    }
+
+    // 异步写请求,由调用线程创建,写线程执行完成后释放
+    struct WriteRequest
+    {
+        std::atomic<WriteRequest*> next{nullptr};
+        std::string sql;
+        std::vector<SQLiteValue> params;
+        std::promise<bool> promise;
+        bool hasPromise = false;
+        WriteCallback callback;
+    };
+
+    std::unique_ptr<Connection> checkpointer_;
+    std::thread checkpoint_thread_;
+    std::mutex checkpoint_mutex_;
+    std::condition_variable checkpoint_condition_;
+    bool checkpoint_stop_ = false;
+
+    // 连接级别的调优参数,写连接、只读连接和checkpoint连接都需要设置
+    static void applyProfile(Connection& connection, const TuningProfile& profile)
+    {
+        sqlite3_busy_timeout(connection.db, profile.busyTimeoutMs);
+        // cache_size为负数时单位为KB
+        const std::string pragmas = "PRAGMA synchronous=" + std::to_string(static_cast<int>(profile.synchronous)) +
+            ";PRAGMA cache_size=-" + std::to_string(profile.cacheSizeKb) +
+            ";PRAGMA mmap_size=" + std::to_string(profile.mmapSize) +
+            ";PRAGMA temp_store=" + std::to_string(static_cast<int>(profile.tempStore)) + ";";
+        char* errMsg = nullptr;
+        if (sqlite3_exec(connection.db, pragmas.c_str(), nullptr, nullptr, &errMsg) != SQLITE_OK)
+        {
+            DLL_LOG_WARN(MODULE_NAME) << "设置调优参数失败: " << errMsg;
+            sqlite3_free(errMsg);
+        }
+    }
+
+    void checkpointLoop(const std::chrono::milliseconds interval)
+    {
+        std::unique_lock lock(checkpoint_mutex_);
+        while (!checkpoint_condition_.wait_for(lock, interval, [this] { return checkpoint_stop_; }))
+        {
+            int logFrames = 0;
+            int checkpointed = 0;
+            const int result = sqlite3_wal_checkpoint_v2(checkpointer_->db, nullptr, SQLITE_CHECKPOINT_PASSIVE,
+                                                         &logFrames, &checkpointed);
+            if (result != SQLITE_OK && result != SQLITE_BUSY)
+            {
+                DLL_LOG_WARN(MODULE_NAME) << "checkpoint失败: " << sqlite3_errmsg(checkpointer_->db);
+            }
+        }
+    }
+
+    void stopCheckpointer()
+    {
+        {
+            std::lock_guard lock(checkpoint_mutex_);
+            checkpoint_stop_ = true;
+        }
+        checkpoint_condition_.notify_all();
+        if (checkpoint_thread_.joinable())
+        {
+            checkpoint_thread_.join();
+        }
+        checkpointer_.reset();
+    }
+
+    MpscQueue<WriteRequest> write_queue_;
+    std::atomic<size_t> write_pending_{0}; // 已入队未执行的请求数
+    std::atomic<bool> write_running_{false};
+    AsyncWriteOptions write_options_; // 由写线程读取
+    std::atomic<size_t> write_batch_size_{1}; // write_options_.maxBatchSize,供入队的线程读取
+    std::thread write_thread_;
+    std::mutex write_mutex_; // 仅用于唤醒写线程
+    std::condition_variable write_condition_;
+    std::mutex write_start_mutex_;
+    bool write_stopped_ = false; // 显式调用过stopAsyncWriter,由write_start_mutex_保护
+
+    void writeLoop()
+    {
+        std::vector<WriteRequest*> batch;
+        while (true)
+        {
+            {
+                std::unique_lock lock(write_mutex_);
+                write_condition_.wait(lock, [this] { return write_pending_ > 0 || !write_running_; });
+                if (write_pending_ == 0)
+                    break;
+                // 在时间窗口内等待攒满一批
+                if (write_running_ && write_options_.maxDelayMs > 0 && write_pending_ < write_options_.maxBatchSize)
+                {
+                    write_condition_.wait_for(lock, std::chrono::milliseconds(write_options_.maxDelayMs), [this]
+                    {
+                        return write_pending_ >= write_options_.maxBatchSize || !write_running_;
+                    });
+                }
+            }
+            const size_t count = std::min(write_pending_.load(), write_options_.maxBatchSize);
+            batch.clear();
+            while (batch.size() < count)
+            {
+                if (WriteRequest* request = write_queue_.pop())
+                    batch.push_back(request);
+                else
+                    std::this_thread::yield(); // 生产者正在入队
+            }
+            write_pending_ -= count;
+            writeBatch(batch);
+        }
+        DLL_LOG_TRACE(MODULE_NAME) << "异步写线程已退出";
+    }
+
+    // 一个批次在同一个事务中执行,每个请求单独回报结果,提交失败时整批失败
+    void writeBatch(const std::vector<WriteRequest*>& batch)
+    {
+        std::vector<bool> results(batch.size(), false);
+        bool committed;
+        {
+            std::lock_guard lock(writer_->mutex);
+            // 使用SAVEPOINT,外部已有事务时作为其中的一部分
+            committed = sqlite3_exec(writer_->db, "SAVEPOINT async_batch;", nullptr, nullptr, nullptr) == SQLITE_OK;
+            if (committed)
+            {
+                for (size_t i = 0; i < batch.size(); ++i)
+                {
+                    results[i] = stepWithParams(*writer_, batch[i]->sql, batch[i]->params);
+                }
+                committed = sqlite3_exec(writer_->db, "RELEASE async_batch;", nullptr, nullptr, nullptr) == SQLITE_OK;
+                if (!committed)
+                {
+                    DLL_LOG_ERROR(MODULE_NAME) << "异步批量写入提交失败: " << sqlite3_errmsg(writer_->db);
+                    sqlite3_exec(writer_->db, "ROLLBACK TO async_batch; RELEASE async_batch;", nullptr, nullptr,
+                                 nullptr);
+                }
+            }
+            else
+            {
+                DLL_LOG_ERROR(MODULE_NAME) << "异步批量写入开始事务失败: " << sqlite3_errmsg(writer_->db);
+            }
+        }
+        // 回调在释放写连接后执行,回调中可以再次访问数据库
+        for (size_t i = 0; i < batch.size(); ++i)
+        {
+            complete(batch[i], committed && results[i]);
+        }
+    }
+
+    static void complete(WriteRequest* request, const bool success)
+    {
+        if (request->hasPromise)
+            request->promise.set_value(success);
+        if (request->callback)
+        {
+            try
+            {
+                request->callback(success);
+            }
+            catch (const std::exception& e)
+            {
+                DLL_LOG_ERROR(MODULE_NAME) << "异步写入回调异常: " << e.what();
+            }
+        }
+        delete request;
+    }
+
+    static std::vector<std::map<std::string, SQLiteValue>> readRows(sqlite3_stmt* stmt)
+    {
+        std::vector<std::map<std::string, SQLiteValue>> results;
+        const Row view(stmt);
+        while (sqlite3_step(stmt) == SQLITE_ROW)
+        {
+            // 列数在step之后读取: 表结构变化时语句在step中重新编译,SELECT *的列可能变化
+            const int colCount = view.columnCount();
+            std::map<std::string, SQLiteValue> row;
+            for (int i = 0; i < colCount; ++i)
+            {
+                row[view.columnName(i)] = view.getValue(i);
+            }
+            results.emplace_back(std::move(row));
+        }
+        return results;
+    }
+
+    // 在只读连接上执行查询语句,语句不是只读时(如 INSERT ... RETURNING)转到写连接执行,
+    // func在持有连接锁期间调用
+    template <typename Func>
+    void runQuery(const std::string& sql, Func&& func)
+    {
+        {
+            ConnectionLock lock;
+            Connection& connection = acquireReader(lock);
+            const StatementHandle handle = prepare(connection, sql);
+            if (!handle)
+            {
+                DLL_LOG_ERROR(MODULE_NAME) << "Failed to prepare statement";
+                throw std::runtime_error("Failed to prepare statement");
+            }
+            if (&connection == writer_.get() || sqlite3_stmt_readonly(handle.get()))
+            {
+                func(handle);
+                return;
+            }
+        }
+        const WriterLock lock(*this);
+        const StatementHandle handle = prepare(*writer_, sql);
+        if (!handle)
+        {
+            DLL_LOG_ERROR(MODULE_NAME) << "Failed to prepare statement";
+            throw std::runtime_error("Failed to prepare statement");
+        }
+        func(handle);
+    }
+#endif
+#ifdef SQLITE3_ENABLE
+    std::atomic<std::thread::id> transaction_owner_{}; // 持有事务的线程,该线程持有写连接的锁
+    int transaction_depth_ = 0; // 事务嵌套层数,只由持有事务的线程访问
+
+    // 结束最外层事务,释放写连接
+    void endTransaction()
+    {
+        transaction_depth_ = 0;
+        transaction_owner_ = std::thread::id();
+        writer_->mutex.unlock();
+    }
+
+    // 写连接锁,当前线程持有事务或已经持有写连接(在写连接上查询的visitor中)时不再重复加锁
+    class WriterLock
+    {
+    public:
+        explicit WriterLock(Impl& impl)
+        {
+            if (impl.transaction_owner_ != std::this_thread::get_id() &&
+                !ConnectionLock::heldByCurrentThread(*impl.writer_))
+            {
+                lock_.lock(*impl.writer_);
+            }
+        }
+
+    private:
+        ConnectionLock lock_;
+    };
+#endif
+};
+
+int SqliteHelper::Row::columnCount() const
+{
+#ifdef SQLITE3_ENABLE
+    return sqlite3_column_count(static_cast<sqlite3_stmt*>(stmt_));
+#else
+    return 0;
+#endif
+}
+
+const char* SqliteHelper::Row::columnName(const int index) const
+{
+#ifdef SQLITE3_ENABLE
+    return sqlite3_column_name(static_cast<sqlite3_stmt*>(stmt_), index);
+#else
+    return "";
+#endif
+}
+
+bool SqliteHelper::Row::isNull(const int index) const
+{
+#ifdef SQLITE3_ENABLE
+    return sqlite3_column_type(static_cast<sqlite3_stmt*>(stmt_), index) == SQLITE_NULL;
+#else
+    return true;
+#endif
+}
+
+SqliteInt64 SqliteHelper::Row::getInt64(const int index) const
+{
+#ifdef SQLITE3_ENABLE
+    return sqlite3_column_int64(static_cast<sqlite3_stmt*>(stmt_), index);
+#else
+    return 0;
+#endif
+}
+
+double SqliteHelper::Row::getDouble(const int index) const
+{
+#ifdef SQLITE3_ENABLE
+    return sqlite3_column_double(static_cast<sqlite3_stmt*>(stmt_), index);
+#else
+    return 0;
+#endif
+}
+
+std::string_view SqliteHelper::Row::getText(const int index) const
+{
+#ifdef SQLITE3_ENABLE
+    auto* stmt = static_cast<sqlite3_stmt*>(stmt_);
+    // 先取数据再取长度,避免类型转换使指针失效
+    const auto* text = reinterpret_cast<const char*>(sqlite3_column_text(stmt, index));
+    if (!text)
+        return {};
+    return {text, static_cast<size_t>(sqlite3_column_bytes(stmt, index))};
+#else
+    return {};
+#endif
+}
+
+SqliteHelper::BlobView SqliteHelper::Row::getBlob(const int index) const
+{
+#ifdef SQLITE3_ENABLE
+    auto* stmt = static_cast<sqlite3_stmt*>(stmt_);
+    const auto* data = static_cast<const uint8_t*>(sqlite3_column_blob(stmt, index));
+    return {data, data ? static_cast<size_t>(sqlite3_column_bytes(stmt, index)) : 0};
+#else
+    return {};
+#endif
+}
+
+SqliteHelper::SQLiteValue SqliteHelper::Row::getValue(const int index) const
+{
+#ifdef SQLITE3_ENABLE
+    switch (sqlite3_column_type(static_cast<sqlite3_stmt*>(stmt_), index))
+    {
+    case SQLITE_NULL:
+        return std::monostate{};
+    case SQLITE_INTEGER:
+        return getInt64(index);
+    case SQLITE_FLOAT:
+        return getDouble(index);
+    case SQLITE_TEXT:
+        return std::string(getText(index));
+    case SQLITE_BLOB:
+    {
+        const BlobView blob = getBlob(index);
+        return std::vector<uint8_t>(blob.data, blob.data + blob.size);
+    }
+    default:
+        DLL_LOG_ERROR(MODULE_NAME) << "Unsupported SQLite data type: " << columnName(index);
+        throw std::runtime_error("Unsupported SQLite data type");
+    }
+#else
+    return std::monostate{};
+#endif
+}
+
+SqliteHelper& SqliteHelper::getInstance()
+{
+    // 先构造日志单例,静态对象按构造的逆序析构,程序退出时先关闭数据库(停止后台线程)再析构日志
+    static SqliteHelper& instance = []() -> SqliteHelper&
+    {
+        Logger::getInstance();
+        static SqliteHelper helper;
+        return helper;
+    }();
+    return instance;
+}
+
+SqliteHelper& SqliteHelper::getInstance(const std::string& name)
+{
+    static std::mutex mutex;
+    static auto& instances = []() -> std::map<std::string, std::unique_ptr<SqliteHelper>>&
+    {
+        Logger::getInstance();
+        static std::map<std::string, std::unique_ptr<SqliteHelper>> helpers;
+        return helpers;
+    }();
+    std::lock_guard lock(mutex);
+    auto& instance = instances[name];
+    if (!instance)
+    {
+        instance = std::make_unique<SqliteHelper>();
+    }
+    return *instance;
+}
+
+bool SqliteHelper::execute(const std::string& sql) const
+{
+    return impl_->execute(sql);
 }
 
 std::vector<std::map<std::string, SqliteHelper::SQLiteValue>> SqliteHelper::query(const std::string& sql) const
 {
-    return impl_->query(sql);
+    return impl_->query(sql, std::vector<SQLiteValue>());
+}
+
+std::vector<std::map<std::string, SqliteHelper::SQLiteValue>> SqliteHelper::query(
+    const std::string& sql, const std::vector<SQLiteValue>& params) const
+{
+    return impl_->query(sql, params);
+}
+
+std::vector<std::map<std::string, SqliteHelper::SQLiteValue>> SqliteHelper::query(
+    const std::string& sql, const NamedParams& params) const
+{
+    return impl_->query(sql, params);
 }
 
 
@@ -265,13 +1359,147 @@ bool SqliteHelper::executeWithParams(const std::string& sql, const std::vector<S
     return impl_->executeWithParams(sql, params);
 }
 
+bool SqliteHelper::executeWithParams(const std::string& sql, const NamedParams& params) const
+{
+    return impl_->executeWithParams(sql, params);
+}
+
+size_t SqliteHelper::queryEach(const std::string& sql, const RowVisitor& visitor) const
+{
+    if (impl_)
+        return impl_->queryEach(sql, std::vector<SQLiteValue>(), visitor, nullptr);
+    return 0;
+}
+
+size_t SqliteHelper::queryEach(const std::string& sql, const std::vector<SQLiteValue>& params,
+                               const RowVisitor& visitor) const
+{
+    if (impl_)
+        return impl_->queryEach(sql, params, visitor, nullptr);
+    return 0;
+}
+
+size_t SqliteHelper::queryEach(const std::string& sql, const NamedParams& params, const RowVisitor& visitor) const
+{
+    if (impl_)
+        return impl_->queryEach(sql, params, visitor, nullptr);
+    return 0;
+}
+
+size_t SqliteHelper::visitRows(const std::string& sql, const std::vector<SQLiteValue>& params,
+                               const RowVisitor& visitor, const std::function<void(size_t)>& reserve) const
+{
+    if (impl_)
+        return impl_->queryEach(sql, params, visitor, reserve);
+    return 0;
+}
+
+size_t SqliteHelper::visitRows(const std::string& sql, const NamedParams& params, const RowVisitor& visitor,
+                               const std::function<void(size_t)>& reserve) const
+{
+    if (impl_)
+        return impl_->queryEach(sql, params, visitor, reserve);
+    return 0;
+}
+
+SqliteHelper::BatchResult SqliteHelper::executeBatch(const std::string& sql,
+                                                     const std::vector<std::vector<SQLiteValue>>& rows) const
+{
+    if (impl_)
+        return impl_->executeBatch(sql, rows);
+    return {};
+}
+
+void SqliteHelper::startAsyncWriter(const AsyncWriteOptions& options) const
+{
+    if (impl_)
+        impl_->startAsyncWriter(options);
+}
+
+void SqliteHelper::stopAsyncWriter() const
+{
+    if (impl_)
+        impl_->stopAsyncWriter();
+}
+
+std::future<bool> SqliteHelper::executeAsync(const std::string& sql, std::vector<SQLiteValue> params) const
+{
+    std::promise<bool> promise;
+    if (!impl_)
+    {
+        promise.set_value(false);
+        return promise.get_future();
+    }
+    auto future = promise.get_future();
+    impl_->executeAsync(sql, std::move(params), &promise, nullptr);
+    return future;
+}
+
+void SqliteHelper::executeAsync(const std::string& sql, std::vector<SQLiteValue> params,
+                                WriteCallback callback) const
+{
+    if (!impl_)
+    {
+        if (callback)
+            callback(false);
+        return;
+    }
+    impl_->executeAsync(sql, std::move(params), nullptr, std::move(callback));
+}
+
+SqliteHelper::StatementCacheStats SqliteHelper::getStatementCacheStats() const
+{
+    if (impl_)
+        return impl_->getStatementCacheStats();
+    return {};
+}
+
+void SqliteHelper::setStatementCacheSize(const size_t capacity) const
+{
+    if (impl_)
+        impl_->setStatementCacheSize(capacity);
+}
+
 SqliteHelper::SqliteHelper():impl_(nullptr)
 {
 }
 
-void SqliteHelper::init(const char* dbPath)
+SqliteHelper::~SqliteHelper()
+{
+    close();
+}
+
+SqliteHelper::TuningProfile SqliteHelper::tuningProfile(const TuningPreset preset)
+{
+    TuningProfile profile;
+    profile.busyTimeoutMs = 5000;
+    if (preset == TuningPreset::DURABLE)
+    {
+        return profile;
+    }
+    profile.synchronous = TuningProfile::Synchronous::NORMAL;
+    profile.cacheSizeKb = 16 * 1024;
+    profile.mmapSize = 256LL * 1024 * 1024;
+    profile.tempStore = TuningProfile::TempStore::MEMORY;
+    profile.journalSizeLimit = 64LL * 1024 * 1024;
+    if (preset == TuningPreset::THROUGHPUT)
+    {
+        profile.cacheSizeKb = 64 * 1024;
+        profile.walAutoCheckpoint = 0;
+        profile.checkpointIntervalMs = 1000;
+    }
+    return profile;
+}
+
+void SqliteHelper::init(const char* dbPath, const int readerCount)
+{
+    init(dbPath, TuningProfile(), readerCount);
+}
+
+void SqliteHelper::init(const char* dbPath, const TuningProfile& profile, const int readerCount)
 {
-    impl_ = new Impl(dbPath);
+    close();
+    impl_ = new Impl(dbPath, profile, readerCount);
 }
 
 SqliteHelper::Transaction::Transaction(SqliteHelper& db):db_(db), committed(false)
@@ -281,7 +1509,8 @@ SqliteHelper::Transaction::Transaction(SqliteHelper& db):db_(db), committed(fals
 
 SqliteHelper::Transaction::~Transaction()
 {
-    if (!committed)
+    // 数据库已关闭时事务已随连接回滚
+    if (!committed && db_.impl_)
     {
         try
         {
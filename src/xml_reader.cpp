@@ -0,0 +1,414 @@
+/**
+# @File     : xml_reader.cpp
+# @Author   : jade
+# @Date     : 2026/10/19 23:10
+# @Email    : jadehh@1ive.com
+# @Software : Samples
+# @Desc     : 基于rapidxml原位解析的XML配置读取
+*/
+#include "include/jade_tools.h"
+#include "include/rapidxml.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <unordered_set>
+#ifdef LOW_GCC
+#include <experimental/filesystem>
+namespace fs = std::experimental::filesystem;
+#else
+#include <filesystem>
+namespace fs = std::filesystem;
+#endif
+#define MODULE_NAME "XmlReader"
+
+using namespace jade;
+
+namespace
+{
+    using XmlNode = rapidxml::xml_node<>;
+
+    std::string_view nameOf(const rapidxml::xml_base<>* node)
+    {
+        return {node->name(), node->name_size()};
+    }
+
+    std::string_view valueOf(const rapidxml::xml_base<>* node)
+    {
+        return {node->value(), node->value_size()};
+    }
+
+    // 路径中的一级: [//]名称[谓词]
+    struct Step
+    {
+        enum class Predicate { NONE, INDEX, ATTRIBUTE, CHILD };
+
+        bool descendant = false;
+        std::string_view name; // "*"匹配任意元素
+        Predicate predicate = Predicate::NONE;
+        size_t index = 0; // 从1开始
+        std::string_view key;
+        std::optional<std::string_view> value;
+
+        [[nodiscard]] bool matches(const XmlNode* node) const
+        {
+            if (node->type() != rapidxml::node_element || (name != "*" && nameOf(node) != name))
+                return false;
+            // rapidxml把长度0当作以'\0'结尾的字符串,空的key不能直接传入
+            if (predicate != Predicate::NONE && predicate != Predicate::INDEX && key.empty())
+                return false;
+            if (predicate == Predicate::ATTRIBUTE)
+            {
+                const auto* attribute = node->first_attribute(key.data(), key.size());
+                return attribute && (!value || valueOf(attribute) == *value);
+            }
+            if (predicate == Predicate::CHILD)
+            {
+                const auto* child = node->first_node(key.data(), key.size());
+                return child && (!value || valueOf(child) == *value);
+            }
+            return true;
+        }
+    };
+
+    struct Path
+    {
+        bool absolute = false;
+        std::vector<Step> steps;
+        std::optional<std::string_view> attribute; // 最后一级的@name
+    };
+
+    // 解析谓词的内容,如 2、@type、@type='hik'、ip="10.0.0.1"
+    bool parsePredicate(std::string_view text, Step& step)
+    {
+        if (text.empty())
+            return false;
+        if (std::all_of(text.begin(), text.end(), [](const char c) { return c >= '0' && c <= '9'; }))
+        {
+            step.predicate = Step::Predicate::INDEX;
+            step.index = std::strtoul(std::string(text).c_str(), nullptr, 10);
+            return step.index > 0;
+        }
+        step.predicate = Step::Predicate::CHILD;
+        if (text.front() == '@')
+        {
+            step.predicate = Step::Predicate::ATTRIBUTE;
+            text.remove_prefix(1);
+        }
+        const size_t equal = text.find('=');
+        step.key = text.substr(0, equal);
+        if (step.key.empty())
+            return false;
+        if (equal == std::string_view::npos)
+            return true;
+        const std::string_view quoted = text.substr(equal + 1);
+        if (quoted.size() < 2 || (quoted.front() != '\'' && quoted.front() != '"') || quoted.back() != quoted.front())
+            return false;
+        step.value = quoted.substr(1, quoted.size() - 2);
+        return true;
+    }
+
+    bool parsePath(const std::string_view text, Path& path)
+    {
+        size_t pos = 0;
+        path.absolute = !text.empty() && text.front() == '/';
+        while (pos < text.size())
+        {
+            Step step;
+            if (text.compare(pos, 2, "//") == 0)
+            {
+                step.descendant = true;
+                pos += 2;
+            }
+            else if (text[pos] == '/')
+            {
+                ++pos;
+            }
+            if (pos < text.size() && text[pos] == '@')
+            {
+                path.attribute = text.substr(pos + 1);
+                return !path.attribute->empty() && !step.descendant &&
+                    path.attribute->find_first_of("/[") == std::string_view::npos;
+            }
+            const size_t end = text.find_first_of("/[", pos);
+            step.name = text.substr(pos, end - pos);
+            if (step.name.empty())
+                return false;
+            pos = end;
+            if (pos < text.size() && text[pos] == '[')
+            {
+                // 谓词的值中可能出现/或],找到引号外的]
+                char quote = 0;
+                size_t close = pos + 1;
+                for (; close < text.size() && (quote || text[close] != ']'); ++close)
+                {
+                    if (quote && text[close] == quote)
+                        quote = 0;
+                    else if (!quote && (text[close] == '\'' || text[close] == '"'))
+                        quote = text[close];
+                }
+                if (close == text.size() || !parsePredicate(text.substr(pos + 1, close - pos - 1), step))
+                    return false;
+                pos = close + 1;
+                if (pos < text.size() && text[pos] != '/')
+                    return false;
+            }
+            path.steps.push_back(step);
+        }
+        return true;
+    }
+
+    // 按文档顺序收集parent下匹配step的元素, [n]对每个父节点分别计数
+    void collect(const XmlNode* parent, const Step& step, std::vector<const XmlNode*>& result)
+    {
+        size_t count = 0;
+        for (const XmlNode* child = parent->first_node(); child; child = child->next_sibling())
+        {
+            if (child->type() != rapidxml::node_element)
+                continue;
+            if (step.matches(child) && (step.predicate != Step::Predicate::INDEX || ++count == step.index))
+            {
+                result.push_back(child);
+                if (step.predicate == Step::Predicate::INDEX && !step.descendant)
+                    break;
+            }
+            if (step.descendant)
+                collect(child, step, result);
+        }
+    }
+
+    std::vector<const XmlNode*> evaluate(const XmlNode* start, const std::string& text, Path& path)
+    {
+        if (!start)
+            return {};
+        if (!parsePath(text, path))
+        {
+            DLL_LOG_WARN(MODULE_NAME) << "无效的路径:" << text;
+            path.attribute.reset();
+            return {};
+        }
+        if (const XmlNode* document = start->document(); path.absolute && document)
+        {
+            start = document;
+        }
+        std::vector<const XmlNode*> current{start};
+        std::vector<const XmlNode*> next;
+        for (const Step& step : path.steps)
+        {
+            next.clear();
+            for (const XmlNode* node : current)
+                collect(node, step, next);
+            if (step.descendant && current.size() > 1)
+            {
+                // 上一级的节点互相嵌套时,同一个后代会被收集多次
+                std::unordered_set<const XmlNode*> seen;
+                next.erase(std::remove_if(next.begin(), next.end(), [&seen](const XmlNode* node)
+                {
+                    return !seen.insert(node).second;
+                }), next.end());
+            }
+            current.swap(next);
+            if (current.empty())
+                break;
+        }
+        return current;
+    }
+
+    const XmlNode* cast(const void* node)
+    {
+        return static_cast<const XmlNode*>(node);
+    }
+}
+
+std::string_view XmlReader::Node::name() const
+{
+    return node_ ? nameOf(cast(node_)) : std::string_view();
+}
+
+std::string_view XmlReader::Node::text() const
+{
+    return node_ ? valueOf(cast(node_)) : std::string_view();
+}
+
+std::optional<std::string_view> XmlReader::Node::attribute(const std::string_view name) const
+{
+    // rapidxml把长度0当作以'\0'结尾的字符串,空的name会按data()中的内容查找
+    if (!node_ || name.empty())
+        return std::nullopt;
+    const auto* attribute = cast(node_)->first_attribute(name.data(), name.size());
+    return attribute ? std::optional(valueOf(attribute)) : std::nullopt;
+}
+
+std::vector<XmlReader::Node> XmlReader::Node::select(const std::string& path) const
+{
+    Path parsed;
+    const std::vector<const XmlNode*> nodes = evaluate(cast(node_), path, parsed);
+    if (parsed.attribute)
+    {
+        DLL_LOG_WARN(MODULE_NAME) << "select不支持选择属性,请使用value:" << path;
+        return {};
+    }
+    std::vector<Node> result;
+    result.reserve(nodes.size());
+    for (const XmlNode* node : nodes)
+        result.emplace_back(Node(node));
+    return result;
+}
+
+XmlReader::Node XmlReader::Node::first(const std::string& path) const
+{
+    const std::vector<Node> nodes = select(path);
+    return nodes.empty() ? Node() : nodes.front();
+}
+
+std::optional<std::string_view> XmlReader::Node::value(const std::string& path) const
+{
+    Path parsed;
+    const std::vector<const XmlNode*> nodes = evaluate(cast(node_), path, parsed);
+    if (nodes.empty())
+        return std::nullopt;
+    const Node node(nodes.front());
+    return parsed.attribute ? node.attribute(*parsed.attribute) : std::optional(node.text());
+}
+
+class XmlReader::Impl
+{
+public:
+    bool load(const std::string& filename)
+    {
+        clear();
+        std::error_code error;
+        FILE* file = fs::is_regular_file(filename, error) ? fopen(filename.c_str(), "rb") : nullptr;
+        if (!file)
+        {
+            return fail("无法打开文件:" + filename);
+        }
+        bool ok = fseek(file, 0, SEEK_END) == 0;
+        const long size = ok ? ftell(file) : -1;
+        ok = size >= 0 && fseek(file, 0, SEEK_SET) == 0;
+        if (ok)
+        {
+            buffer_.resize(static_cast<size_t>(size));
+            ok = fread(buffer_.data(), 1, buffer_.size(), file) == buffer_.size();
+        }
+        fclose(file);
+        if (!ok)
+        {
+            return fail("读取文件失败:" + filename);
+        }
+        return parse(filename);
+    }
+
+    bool parse(const char* data, const size_t size)
+    {
+        clear();
+        buffer_.assign(data, size);
+        return parse(std::string("<内存>"));
+    }
+
+    [[nodiscard]] const std::string& error() const
+    {
+        return error_;
+    }
+
+    [[nodiscard]] const XmlNode* document() const
+    {
+        return &document_;
+    }
+
+private:
+    // 解析时直接修改buffer_,元素名、文本和属性都指向buffer_
+    std::string buffer_;
+    // 节点分配在文档自带的内存池中,clear只释放动态申请的内存块,重新加载时复用初始的静态块
+    rapidxml::xml_document<> document_;
+    std::string error_;
+
+    void clear()
+    {
+        document_.clear();
+        error_.clear();
+    }
+
+    bool fail(const std::string& message)
+    {
+        document_.clear();
+        error_ = message;
+        DLL_LOG_ERROR(MODULE_NAME) << error_;
+        return false;
+    }
+
+    bool parse(const std::string& source)
+    {
+        try
+        {
+            // std::string保证末尾有'\0',满足rapidxml对输入的要求
+            document_.parse<rapidxml::parse_trim_whitespace>(buffer_.data());
+        }
+        catch (const rapidxml::parse_error& e)
+        {
+            // 解析过程中已写入的'\0'可能覆盖了换行,行号仅供参考
+            const char* where = e.where<char>();
+            const auto line = 1 + std::count(static_cast<const char*>(buffer_.data()), where, '\n');
+            return fail(source + "第" + std::to_string(line) + "行附近解析失败:" + e.what());
+        }
+        if (!document_.first_node())
+        {
+            return fail(source + "中没有根元素");
+        }
+        DLL_LOG_TRACE(MODULE_NAME) << "加载XML配置:" << source << ",大小:" << static_cast<int>(buffer_.size());
+        return true;
+    }
+};
+
+XmlReader::XmlReader(): impl_(new Impl)
+{
+}
+
+XmlReader::XmlReader(const std::string& filename): impl_(new Impl)
+{
+    impl_->load(filename);
+}
+
+XmlReader::~XmlReader()
+{
+    delete impl_;
+}
+
+bool XmlReader::load(const std::string& filename)
+{
+    return impl_->load(filename);
+}
+
+bool XmlReader::parse(const char* data, const size_t size)
+{
+    return impl_->parse(data, size);
+}
+
+const std::string& XmlReader::error() const
+{
+    return impl_->error();
+}
+
+XmlReader::Node XmlReader::document() const
+{
+    return Node(impl_->document());
+}
+
+XmlReader::Node XmlReader::root() const
+{
+    return Node(impl_->document()->first_node());
+}
+
+std::vector<XmlReader::Node> XmlReader::select(const std::string& path) const
+{
+    return document().select(path);
+}
+
+XmlReader::Node XmlReader::first(const std::string& path) const
+{
+    return document().first(path);
+}
+
+std::optional<std::string_view> XmlReader::value(const std::string& path) const
+{
+    return document().value(path);
+}
@@ -9,6 +9,23 @@
 #include "test/include/testINIReader.h"
 #include <sstream>
 
+struct UserConfig
+{
+    std::string name;
+    std::string email;
+    double pi = 0;
+    bool active = false;
+    long version = 0;
+};
+
+// 配置结构的字段描述,加载时一次读取并校验
+constexpr auto userSchema = jade::makeINISchema(
+    jade::iniField("user", "name", &UserConfig::name),
+    jade::iniField("user", "email", &UserConfig::email, ""),
+    jade::iniField("user", "pi", &UserConfig::pi).between(3.0, 4.0),
+    jade::iniField("user", "active", &UserConfig::active, false),
+    jade::iniField("protocol", "version", &UserConfig::version).between(4, 6));
+
 std::string sections(const jade::INIReader& reader)
 {
     std::stringstream ss;
@@ -33,6 +50,11 @@ void testInIReader()
     else
     {
         auto configs = reader.GetIntegerWithPrefix("EIO","EIOOutputBitNumber");
+        std::stringstream keys;
+        for (const auto& key : reader.Keys("EIO"))
+            keys << key << ",";
+        LOG_DEBUG() << "EIO keys=" << keys.str() << " output bits=" << configs.size()
+            << " ip=" << reader.GetStringWithPrefix("EIO", "EIOIp").front();
         LOG_DEBUG() << "Config loaded from 'test.ini': found sections="
             << sections(reader)
             << " version=" << reader.GetInteger("protocol", "version", -1)
@@ -41,6 +63,46 @@ void testInIReader()
             << ", multi=" << reader.Get("user", "multi", "UNKNOWN")
             << ", pi=" << reader.GetReal("user", "pi", -1)
             << ", active=" << reader.GetBoolean("user", "active", true);
+
+        UserConfig user;
+        if (std::vector<std::string> errors; !userSchema.load(reader, user, errors))
+        {
+            for (const auto& error : errors)
+                LOG_ERROR() << "Invalid config: " << error;
+        }
+        LOG_DEBUG() << "Schema loaded: name=" << user.name << ", pi=" << user.pi << ", version=" << user.version;
+
+        // 频繁读取的配置预先查找Key,之后按Key读取
+        const jade::INIReader::Key version = reader.key("protocol", "version");
+        const jade::INIReader::Key pi = reader.key("user", "pi");
+        LOG_DEBUG() << "Read by key: version=" << reader.GetInteger(version, -1)
+            << ", pi=" << reader.GetReal(pi, -1)
+            << ", valid=" << version.valid();
     }
+
+    // 二进制缓存: 第一次解析后生成缓存,之后直接映射缓存文件
+    if (jade::ConfigCache cache; cache.open(filename, jade::ConfigCache::Format::INI))
+    {
+        LOG_DEBUG() << "Config cache: fromCache=" << cache.fromCache() << ", keys=" << cache.size()
+            << ", version=" << cache.GetInteger("protocol", "version", -1);
+    }
+
+    // XML配置: 原位解析,按路径读取
+    const std::string xml = R"(<config><user name="Bob Smith"><pi>3.14159</pi></user><protocol version="6"/></config>)";
+    if (jade::XmlReader xmlReader; xmlReader.parse(xml.data(), xml.size()))
+    {
+        LOG_DEBUG() << "Xml config: name=" << xmlReader.get<std::string>("/config/user/@name", "")
+            << ", pi=" << xmlReader.get("//user/pi", 0.0) << ", version=" << xmlReader.get("//protocol/@version", -1);
+    }
+
+    // 热加载: 配置文件修改后自动重新加载,只通知内容变化的节
+    const jade::INIWatcher watcher(filename);
+    watcher.onSectionChanged("user", [](const std::string& section, const jade::INIWatcher::Snapshot& previous,
+                                        const jade::INIWatcher::Snapshot& current)
+    {
+        LOG_DEBUG() << "Section changed: " << section << ", name=" << previous->Get(section, "name", "")
+            << " -> " << current->Get(section, "name", "");
+    });
+    LOG_DEBUG() << "Watching config, version=" << watcher.snapshot()->GetInteger("protocol", "version", -1);
     LOG_INFO() << "=====================================ini文件解析测试结束" << "=====================================";
 }
@@ -40,6 +40,15 @@ void testOpencv()
     const jade::RtspVideoCapture::RtspInfo left_hik_info(
         "侧相机", "admin", "samples123", "192.168.29.179", 554, "", true, 30,
         jade::RtspVideoCapture::RtspDeviceType::HIKVISION);
+    // 也可以从XML相机清单生成
+    const std::string inventory = R"(<inventory><camera name="前相机" ip="192.168.29.181" type="hik">)"
+        R"(<user>admin</user><password>samples123</password><use_gpu>true</use_gpu><frame_interval>30</frame_interval>)"
+        R"(</camera></inventory>)";
+    jade::XmlReader reader;
+    if (reader.parse(inventory.data(), inventory.size()))
+    {
+        LOG_DEBUG() << "Cameras from xml: " << static_cast<int>(jade::RtspVideoCapture::RtspInfo::fromXml(reader).size());
+    }
     // 添加多个RTSP流
     const std::vector streams = {front_hik_info};
     for (const auto& rtsp : streams)
@@ -8,6 +8,7 @@
 */
 #include "test/include/testSocket.h"
 
+#include <memory>
 #include <thread>
 
 void MessageHandle(SOCKET_TYPE socket, const char*data, size_t size)
@@ -15,12 +16,36 @@ void MessageHandle(SOCKET_TYPE socket, const char*data, size_t size)
     LOG_DEBUG() << "处理socket自定义信息" << socket << data;
 }
 
+void DatagramHandle(SOCKET_TYPE socket, const char* data, size_t size, const jade::SocketServer::PeerAddress& peer)
+{
+    LOG_DEBUG() << "处理UDP数据报,来源:" << jade::getIntAsIp(peer.ip) << ":" << static_cast<int>(peer.port) << ",长度:"
+        << static_cast<int>(size);
+}
+
 void testSocketServer()
 {
     LOG_INFO() << "=====================================Socket Server测试开始" << "=====================================";
-    std::shared_ptr<jade::SocketServer> socket_server = std::make_shared<jade::SocketServer>(8099,MessageHandle);
+    jade::SocketServer::Options options;
+    options.readIdleTimeoutMs = 3000; // 3秒未收到数据则断开
+    options.writeTimeoutMs = 1000;
+    options.maxConnections = 64;
+    options.maxConnectionsPerIp = 8;
+    std::shared_ptr<jade::SocketServer> socket_server = std::make_shared<jade::SocketServer>(8099,MessageHandle,options);
     socket_server->start();
+
+    jade::SocketServer::Options udp_options;
+    udp_options.transport = jade::SocketServer::Transport::UDP;
+    udp_options.udpSocketCount = 2;
+    std::shared_ptr<jade::SocketServer> udp_server = std::make_shared<jade::SocketServer>(8098,DatagramHandle,udp_options);
+    udp_server->start();
     std::this_thread::sleep_for(std::chrono::seconds(5));
+    const auto stats = socket_server->getStats();
+    LOG_INFO() << "TCP连接总数:" << static_cast<int>(stats.totalConnections) << ",接收消息数:"
+        << static_cast<int>(stats.messagesIn) << ",分帧错误:" << static_cast<int>(stats.framingErrors);
+    const auto udp_stats = udp_server->getStats();
+    LOG_INFO() << "UDP接收数据报:" << static_cast<int>(udp_stats.messagesIn) << ",接收字节:"
+        << static_cast<int>(udp_stats.bytesIn);
+    udp_server->stop();
     socket_server->stop();
     LOG_INFO() << "=====================================Socket Server测试结束" << "=====================================";
 }
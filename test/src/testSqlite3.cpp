@@ -11,6 +11,13 @@
 
 #include <iostream>
 #include <string>
+
+struct User
+{
+    SqliteInt64 id;
+    std::string name;
+    std::optional<SqliteInt64> age;
+};
 // 多线程使用示例
 void workerTask(const int id)
 {
@@ -36,11 +43,37 @@ void workerTask(const int id)
             {
                 LOG_WARN() << "Failed to update age";
             }
+            // 嵌套事务对应SAVEPOINT,未提交时只回滚自身的写入
+            {
+                jade::SqliteHelper::Transaction nested(db);
+                (void)db.execute("INSERT INTO users (name, age) VALUES ('NestedUser', 20);");
+            }
             trans.commit();
         }
 
+        // 异步写入,由后台线程合并到一个事务中执行
+        auto inserted = db.executeAsync("INSERT INTO users (name, age) VALUES (?, ?);",
+                                        {"AsyncUser" + std::to_string(id), 30.0});
+        if (!inserted.get())
+        {
+            LOG_WARN() << "Failed to insert users asynchronously";
+        }
+
         // 查询数据
         const auto results = db.query("SELECT * FROM users;");
+        // 逐行遍历,不拷贝TEXT列
+        size_t name_bytes = 0;
+        db.queryEach("SELECT name, age FROM users;", [&name_bytes](const jade::SqliteHelper::Row& row)
+        {
+            name_bytes += row.getText(0).size();
+            return true;
+        });
+        // 按列的位置映射到结构体
+        const auto users = db.query<User>("SELECT id, name, age FROM users;");
+        // 参数化查询,支持位置参数与命名参数
+        const auto adults = db.query("SELECT name FROM users WHERE age >= ?;", {static_cast<SqliteInt64>(18)});
+        const auto named = db.query<User>("SELECT id, name, age FROM users WHERE name = :name;",
+                                          jade::SqliteHelper::NamedParams{{"name", "User" + std::to_string(id)}});
     }
     catch (const std::exception& e)
     {
@@ -70,5 +103,34 @@ void testSqlite3()
     {
         t.join();
     }
+    const auto cache_stats = jade::SqliteHelper::getInstance().getStatementCacheStats();
+    LOG_INFO() << "预编译语句缓存命中:" << static_cast<int>(cache_stats.hits) << ",未命中:"
+        << static_cast<int>(cache_stats.misses) << ",缓存数量:" << static_cast<int>(cache_stats.size);
+    // 归档库使用独立的实例,与默认实例互不阻塞
+    auto& archive = jade::SqliteHelper::getInstance("archive");
+    archive.init("archive.db", jade::SqliteHelper::tuningProfile(jade::SqliteHelper::TuningPreset::THROUGHPUT), 1);
+    if (!archive.execute("CREATE TABLE IF NOT EXISTS users (id INTEGER PRIMARY KEY, name TEXT NOT NULL, age INTEGER)"))
+    {
+        LOG_WARN() << "Failed to create archive table";
+    }
+    archive.close();
+    // 按天分区的事件存储,过期分区直接删除文件
+    jade::EventStore::Options options;
+    options.directory = "events";
+    options.columns = "camera INTEGER, label TEXT, score REAL";
+    options.retentionDays = 7;
+    const jade::EventStore store(options);
+    const SqliteInt64 now = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    if (!store.insert({now, static_cast<SqliteInt64>(1), std::string("person"), 0.9}))
+    {
+        LOG_WARN() << "Failed to insert event";
+    }
+    const size_t events = store.query(now - 3600 * 1000, now + 1, [](const jade::SqliteHelper::Row&)
+    {
+        return true;
+    }, "label = ?", {std::string("person")});
+    LOG_INFO() << "最近一小时的事件数:" << static_cast<int>(events) << ",分区数:"
+        << static_cast<int>(store.partitions().size());
     LOG_INFO() << "=====================================Sqlite3 测试结束" << "=====================================";
 }
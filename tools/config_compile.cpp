@@ -0,0 +1,58 @@
+/**
+# @File     : config_compile.cpp
+# @Author   : jade
+# @Date     : 2026/10/19 22:40
+# @Email    : jadehh@1ive.com
+# @Software : Samples
+# @Desc     : 预先生成配置二进制缓存
+#
+# 用法: config_compile [--xml] <配置文件> [缓存文件]
+#   解析INI(指定--xml时为XML)配置文件并生成二进制缓存,缓存文件默认为<配置文件>.cache;
+#   程序启动时ConfigCache::open直接映射缓存,源文件修改后自动重新生成
+*/
+#include "include/jade_tools.h"
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+
+int main(const int argc, char* argv[])
+{
+    jade::ConfigCache::Format format = jade::ConfigCache::Format::INI;
+    std::vector<std::string> paths;
+    for (int i = 1; i < argc; ++i)
+    {
+        if (const std::string arg = argv[i]; arg == "--xml")
+            format = jade::ConfigCache::Format::XML;
+        else
+            paths.push_back(arg);
+    }
+    if (paths.empty() || paths.size() > 2)
+    {
+        std::cerr << "用法: config_compile [--xml] <配置文件> [缓存文件]" << std::endl;
+        return 1;
+    }
+    jade::Logger::getInstance().init("config_compile", "tools", "Logs", jade::Logger::S_WARNING, true, false);
+    const std::string source = paths[0];
+    const std::string cache = paths.size() > 1 ? paths[1] : source + ".cache";
+
+    auto begin = std::chrono::steady_clock::now();
+    const bool compiled = jade::ConfigCache::compile(source, format, cache);
+    const double compileMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+    if (!compiled)
+    {
+        std::cerr << "生成缓存失败: " << source << std::endl;
+        jade::Logger::getInstance().shutDown();
+        return 1;
+    }
+
+    // 重新打开一次,确认缓存可以直接使用
+    jade::ConfigCache reader;
+    begin = std::chrono::steady_clock::now();
+    const bool opened = reader.open(source, format, cache) && reader.fromCache();
+    const double openMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+    std::cout << cache << ": 键数 " << reader.size() << ", 生成耗时 " << jade::formatValue(compileMs, 1)
+        << "ms, 加载耗时 " << jade::formatValue(openMs, 2) << "ms" << (opened ? "" : " (缓存无效)") << std::endl;
+    jade::Logger::getInstance().shutDown();
+    return opened ? 0 : 1;
+}